@@ -2,6 +2,8 @@
 #include <unordered_map>
 #include <vector>
 #include <set>
+#include <map>
+#include <unordered_set>
 #include <limits>
 #include <fstream>
 #include <string>
@@ -13,6 +15,28 @@
 #include <iomanip>  // Para mejor formato de salida
 #include <chrono>   // Para medir tiempos de respuesta
 #include <queue>    // Para implementación alternativa de Dijkstra
+#include <memory>
+#include <mutex>
+#include <thread>   // Para el preprocesamiento paralelo de landmarks
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>  // Archivos temporales del ordenamiento externo
+#include <string_view>
+#include <type_traits>
+#include <variant>    // Arreglos de costos con ancho elegido en ejecución
+
+#ifdef __linux__
+#include <linux/perf_event.h>  // Contador de fallos de caché para el benchmark
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>  // mallinfo2 para medir memoria en el benchmark
+#endif
 
 using namespace std;
 
@@ -26,52 +50,823 @@ struct EstadisticasRed {
     int gradoMaximo;  // Número máximo de conexiones de un enrutador
 };
 
+constexpr int DISTANCIA_INFINITA = numeric_limits<int>::max();
+
+// "Infinito" de un tipo de costo: el máximo en enteros, infinity() en flotantes
+template <typename Costo>
+constexpr Costo costoInfinito() {
+    if constexpr (numeric_limits<Costo>::has_infinity) return numeric_limits<Costo>::infinity();
+    else return numeric_limits<Costo>::max();
+}
+
+// Suma de costos no negativos que se satura en costoInfinito() en vez de desbordarse
+template <typename Costo>
+constexpr Costo sumaSaturada(Costo a, Costo b) {
+    if constexpr (is_floating_point_v<Costo>) {
+        return a + b;
+    } else {
+        return (b > costoInfinito<Costo>() - a) ? costoInfinito<Costo>() : static_cast<Costo>(a + b);
+    }
+}
+
+// Costos de arista con el ancho más estrecho que admite el costo máximo de la red
+using CostosAristas = variant<vector<uint8_t>, vector<uint16_t>, vector<uint32_t>>;
+
+CostosAristas costosParaMaximo(int costoMaximo) {
+    if (costoMaximo <= numeric_limits<uint8_t>::max()) return vector<uint8_t>{};
+    if (costoMaximo <= numeric_limits<uint16_t>::max()) return vector<uint16_t>{};
+    return vector<uint32_t>{};
+}
+
+// Arreglo vacío del más ancho de los dos tipos de costos
+CostosAristas costosMasAnchos(const CostosAristas& a, const CostosAristas& b) {
+    return visit([](const auto& c) -> CostosAristas { return decay_t<decltype(c)>{}; },
+                 a.index() >= b.index() ? a : b);
+}
+
+// Representación plana (CSR) de la red usada por las consultas intensivas.
+// Cada enrutador recibe un índice denso; sus vecinos ocupan el rango
+// [inicioAdyacencia[v], inicioAdyacencia[v + 1]) de los arreglos vecinos/costos.
+struct GrafoPlano {
+    vector<string> nombres;               // índice -> nombre
+    unordered_map<string, int> indices;   // nombre -> índice
+    vector<int> inicioAdyacencia;
+    vector<int> vecinos;
+    CostosAristas costos;
+
+    int numeroNodos() const { return static_cast<int>(nombres.size()); }
+
+    int costo(int arista) const {
+        return visit([arista](const auto& c) { return static_cast<int>(c[arista]); }, costos);
+    }
+
+    size_t bytesPorCosto() const {
+        return visit([](const auto& c) { return sizeof(typename decay_t<decltype(c)>::value_type); }, costos);
+    }
+};
+
+// Numeración de los enrutadores al construir el grafo plano. Un buen orden deja
+// a los vecinos cerca en memoria y reduce los fallos de caché al relajar aristas.
+enum class OrdenEnrutadores {
+    Ninguno,                // Orden de iteración de la tabla de enrutadores
+    BFS,                    // Recorrido en anchura desde el nodo de menor grado
+    CuthillMcKeeInverso,    // Reverse Cuthill-McKee (minimiza el ancho de banda)
+    Gorder                  // Agrupa nodos que comparten vecinos dentro de una ventana
+};
+
+// Criterio para escoger los landmarks del oráculo ALT
+enum class SeleccionLandmarks {
+    MasLejano,   // Cada landmark es el enrutador más alejado de los ya escogidos
+    MayorGrado   // Los k enrutadores con más conexiones
+};
+
+// Distancias desde k landmarks guardadas de forma intercalada:
+// distancias[v * k + i] es la distancia entre el landmark i y el enrutador v.
+struct IndiceLandmarks {
+    // Las distancias se calculan en 64 bits y las que no caben en int se guardan
+    // como TOPE, que sigue siendo una cota inferior válida. DISTANCIA_INFINITA
+    // solo marca los nodos que el landmark no alcanza.
+    static constexpr int TOPE = DISTANCIA_INFINITA - 1;
+
+    shared_ptr<const GrafoPlano> grafo;
+    int k = 0;
+    vector<int> landmarks;
+    vector<int> distancias;
+
+    const int* filaDe(int nodo) const { return distancias.data() + static_cast<size_t>(nodo) * k; }
+};
+
+// Cotas del costo entre dos enrutadores calculadas con los landmarks
+struct CotasCosto {
+    int inferior;
+    int superior;      // DISTANCIA_INFINITA si ningún landmark alcanza a ambos
+    bool alcanzable;   // false si los landmarks demuestran que no hay ruta
+};
+
+// Dijkstra sobre el grafo plano, especializado en tiempo de compilación para el
+// tipo de costo de las aristas y el de las distancias acumuladas. Los nodos no
+// alcanzables (o cuya distancia se satura) quedan en costoInfinito<Distancia>().
+template <typename CostoArista, typename Distancia>
+void dijkstraPlano(const GrafoPlano& grafo, const vector<CostoArista>& costos, int origen,
+                   vector<Distancia>& distancias) {
+    distancias.assign(grafo.numeroNodos(), costoInfinito<Distancia>());
+    priority_queue<pair<Distancia, int>, vector<pair<Distancia, int>>, greater<>> cola;
+    distancias[origen] = 0;
+    cola.push({0, origen});
+
+    while (!cola.empty()) {
+        auto [dist, actual] = cola.top();
+        cola.pop();
+        if (dist > distancias[actual]) continue;
+
+        for (int e = grafo.inicioAdyacencia[actual]; e < grafo.inicioAdyacencia[actual + 1]; ++e) {
+            int vecino = grafo.vecinos[e];
+            Distancia nuevaDist = sumaSaturada(dist, static_cast<Distancia>(costos[e]));
+            if (nuevaDist < distancias[vecino]) {
+                distancias[vecino] = nuevaDist;
+                cola.push({nuevaDist, vecino});
+            }
+        }
+    }
+}
+
+// Despacha al Dijkstra especializado para el ancho de costos del grafo
+template <typename Distancia>
+void calcularDistanciasDesde(const GrafoPlano& grafo, int origen, vector<Distancia>& distancias) {
+    visit([&](const auto& costos) { dijkstraPlano(grafo, costos, origen, distancias); }, grafo.costos);
+}
+
+// Búferes reutilizables de una búsqueda de ruta. Hay uno por hilo, así que las
+// consultas repetidas no reservan memoria una vez alcanzado el tamaño de la red.
+struct EspacioBusqueda {
+    vector<uint64_t> distancias;
+    vector<int> anterior;
+    vector<int> tocados;                      // Nodos a reiniciar en la siguiente búsqueda
+    vector<pair<uint64_t, int>> monticulo;
+    vector<int> ruta;
+
+    static EspacioBusqueda& delHilo() {
+        thread_local EspacioBusqueda espacio;
+        return espacio;
+    }
+};
+
+// Ruta obtenida sobre el grafo plano sin copiar nombres: los índices del camino
+// viven en el búfer de búsqueda del hilo y los nombres se consultan bajo demanda
+// como string_view. Es válida hasta la siguiente consulta en el mismo hilo.
+class VistaRuta {
+private:
+    shared_ptr<const GrafoPlano> grafo;
+    const int* indices = nullptr;
+    size_t tamano = 0;
+    uint64_t costoTotal = costoInfinito<uint64_t>();
+
+public:
+    VistaRuta() = default;
+    VistaRuta(shared_ptr<const GrafoPlano> grafoRuta, const int* inicio, size_t numNodos, uint64_t costo)
+        : grafo(move(grafoRuta)), indices(inicio), tamano(numNodos), costoTotal(costo) {}
+
+    bool existe() const { return tamano > 0; }
+    uint64_t costo() const { return costoTotal; }
+    size_t saltos() const { return tamano > 0 ? tamano - 1 : 0; }
+
+    // Índices de los enrutadores del camino, del origen al destino
+    size_t size() const { return tamano; }
+    const int* begin() const { return indices; }
+    const int* end() const { return indices + tamano; }
+    int operator[](size_t posicion) const { return indices[posicion]; }
+
+    string_view nombre(size_t posicion) const { return grafo->nombres[indices[posicion]]; }
+
+    // Primer enrutador después del origen; -1 si no hay ruta o origen y destino coinciden
+    int siguienteSalto() const { return tamano > 1 ? indices[1] : -1; }
+
+    vector<string> materializar() const {
+        vector<string> nombres;
+        nombres.reserve(tamano);
+        for (size_t i = 0; i < tamano; ++i) nombres.emplace_back(nombre(i));
+        return nombres;
+    }
+};
+
+// Dijkstra con parada en el destino sobre los búferes del hilo. Solo se
+// reinician las posiciones que tocó la búsqueda anterior.
+template <typename CostoArista>
+void buscarHastaDestino(const GrafoPlano& grafo, const vector<CostoArista>& costos,
+                        int origen, int destino, EspacioBusqueda& espacio) {
+    constexpr uint64_t infinito = costoInfinito<uint64_t>();
+    size_t n = grafo.numeroNodos();
+    if (espacio.distancias.size() < n) {
+        espacio.distancias.assign(n, infinito);
+        espacio.anterior.resize(n);
+        espacio.tocados.clear();
+    }
+    for (int v : espacio.tocados) espacio.distancias[v] = infinito;
+    espacio.tocados.clear();
+
+    auto& monticulo = espacio.monticulo;
+    monticulo.clear();
+    espacio.distancias[origen] = 0;
+    espacio.anterior[origen] = -1;
+    espacio.tocados.push_back(origen);
+    monticulo.push_back({0, origen});
+
+    while (!monticulo.empty()) {
+        pop_heap(monticulo.begin(), monticulo.end(), greater<>());
+        auto [dist, actual] = monticulo.back();
+        monticulo.pop_back();
+        if (actual == destino) break;
+        if (dist > espacio.distancias[actual]) continue;
+
+        for (int e = grafo.inicioAdyacencia[actual]; e < grafo.inicioAdyacencia[actual + 1]; ++e) {
+            int vecino = grafo.vecinos[e];
+            uint64_t nuevaDist = sumaSaturada(dist, static_cast<uint64_t>(costos[e]));
+            if (nuevaDist < espacio.distancias[vecino]) {
+                if (espacio.distancias[vecino] == infinito) espacio.tocados.push_back(vecino);
+                espacio.distancias[vecino] = nuevaDist;
+                espacio.anterior[vecino] = actual;
+                monticulo.push_back({nuevaDist, vecino});
+                push_heap(monticulo.begin(), monticulo.end(), greater<>());
+            }
+        }
+    }
+}
+
+VistaRuta buscarRuta(shared_ptr<const GrafoPlano> grafo, int origen, int destino) {
+    auto& espacio = EspacioBusqueda::delHilo();
+    visit([&](const auto& costos) { buscarHastaDestino(*grafo, costos, origen, destino, espacio); },
+          grafo->costos);
+
+    espacio.ruta.clear();
+    uint64_t costo = espacio.distancias[destino];
+    if (costo == costoInfinito<uint64_t>()) return {};
+    for (int v = destino; v != -1; v = espacio.anterior[v]) espacio.ruta.push_back(v);
+    reverse(espacio.ruta.begin(), espacio.ruta.end());
+    return VistaRuta(move(grafo), espacio.ruta.data(), espacio.ruta.size(), costo);
+}
+
+// Orden en anchura: cada componente empieza en su nodo de menor grado y los
+// vecinos se visitan por grado creciente cuando porGrado es verdadero (Cuthill-McKee)
+vector<int> ordenEnAnchura(const GrafoPlano& grafo, bool porGrado) {
+    int n = grafo.numeroNodos();
+    auto grado = [&](int v) { return grafo.inicioAdyacencia[v + 1] - grafo.inicioAdyacencia[v]; };
+
+    vector<int> candidatos(n);
+    for (int v = 0; v < n; ++v) candidatos[v] = v;
+    stable_sort(candidatos.begin(), candidatos.end(), [&](int a, int b) { return grado(a) < grado(b); });
+
+    vector<int> orden;
+    orden.reserve(n);
+    vector<char> visitado(n, 0);
+    vector<int> nivel(n, 0);
+    vector<int> vecinos;
+
+    auto recorrer = [&](int inicio) {
+        size_t primero = orden.size();
+        visitado[inicio] = 1;
+        nivel[inicio] = 0;
+        orden.push_back(inicio);
+        for (size_t i = primero; i < orden.size(); ++i) {
+            int actual = orden[i];
+            vecinos.clear();
+            for (int e = grafo.inicioAdyacencia[actual]; e < grafo.inicioAdyacencia[actual + 1]; ++e) {
+                int vecino = grafo.vecinos[e];
+                if (!visitado[vecino]) {
+                    visitado[vecino] = 1;
+                    nivel[vecino] = nivel[actual] + 1;
+                    vecinos.push_back(vecino);
+                }
+            }
+            if (porGrado) {
+                sort(vecinos.begin(), vecinos.end(), [&](int a, int b) { return grado(a) < grado(b); });
+            }
+            orden.insert(orden.end(), vecinos.begin(), vecinos.end());
+        }
+        return primero;
+    };
+
+    for (int inicio : candidatos) {
+        if (visitado[inicio]) continue;
+        if (!porGrado) {
+            recorrer(inicio);
+            continue;
+        }
+        // Nodo pseudo-periférico: el de menor grado en el último nivel de un primer recorrido
+        size_t primero = recorrer(inicio);
+        int periferico = orden.back();
+        for (size_t i = orden.size(); i-- > primero && nivel[orden[i]] == nivel[orden.back()];) {
+            if (grado(orden[i]) < grado(periferico)) periferico = orden[i];
+        }
+        for (size_t i = primero; i < orden.size(); ++i) visitado[orden[i]] = 0;
+        orden.resize(primero);
+        recorrer(periferico);
+    }
+
+    if (porGrado) reverse(orden.begin(), orden.end());
+    return orden;
+}
+
+// Gorder (Wei et al.): coloca junto a la ventana de los últimos nodos ubicados
+// al candidato que más vecinos y hermanos comparte con ella. Los puntajes se
+// mantienen en una cola de cubetas, ya que solo cambian de uno en uno.
+vector<int> ordenGorder(const GrafoPlano& grafo, int ventana = 5) {
+    int n = grafo.numeroNodos();
+    if (n == 0) return {};
+    auto grado = [&](int v) { return grafo.inicioAdyacencia[v + 1] - grafo.inicioAdyacencia[v]; };
+    // Los concentradores muy grandes no aportan localidad entre hermanos y son costosos
+    int gradoHermanos = max(1, static_cast<int>(sqrt(static_cast<double>(n))));
+
+    vector<int> puntaje(n, 0), siguiente(n, -1), previo(n, -1);
+    vector<int> cabeza(1, -1);
+    vector<char> ubicado(n, 0);
+    int puntajeMaximo = 0;
+
+    auto quitar = [&](int v) {
+        if (previo[v] != -1) siguiente[previo[v]] = siguiente[v];
+        else cabeza[puntaje[v]] = siguiente[v];
+        if (siguiente[v] != -1) previo[siguiente[v]] = previo[v];
+    };
+    auto insertar = [&](int v) {
+        if (puntaje[v] >= static_cast<int>(cabeza.size())) cabeza.resize(puntaje[v] + 1, -1);
+        previo[v] = -1;
+        siguiente[v] = cabeza[puntaje[v]];
+        if (siguiente[v] != -1) previo[siguiente[v]] = v;
+        cabeza[puntaje[v]] = v;
+        puntajeMaximo = max(puntajeMaximo, puntaje[v]);
+    };
+    auto ajustar = [&](int v, int delta) {
+        if (ubicado[v]) return;
+        quitar(v);
+        puntaje[v] += delta;
+        insertar(v);
+    };
+    // Suma delta a los vecinos de u y a los vecinos de sus vecinos (hermanos)
+    auto propagar = [&](int u, int delta) {
+        for (int e = grafo.inicioAdyacencia[u]; e < grafo.inicioAdyacencia[u + 1]; ++e) {
+            int x = grafo.vecinos[e];
+            ajustar(x, delta);
+            if (grado(x) > gradoHermanos) continue;
+            for (int f = grafo.inicioAdyacencia[x]; f < grafo.inicioAdyacencia[x + 1]; ++f) {
+                if (grafo.vecinos[f] != u) ajustar(grafo.vecinos[f], delta);
+            }
+        }
+    };
+
+    for (int v = n - 1; v >= 0; --v) insertar(v);
+    int inicio = 0;
+    for (int v = 1; v < n; ++v) {
+        if (grado(v) > grado(inicio)) inicio = v;
+    }
+
+    vector<int> orden;
+    orden.reserve(n);
+    int actual = inicio;
+    while (true) {
+        quitar(actual);
+        ubicado[actual] = 1;
+        orden.push_back(actual);
+        propagar(actual, 1);
+        if (static_cast<int>(orden.size()) > ventana) {
+            propagar(orden[orden.size() - ventana - 1], -1);
+        }
+        if (static_cast<int>(orden.size()) == n) break;
+
+        while (puntajeMaximo > 0 && cabeza[puntajeMaximo] == -1) --puntajeMaximo;
+        actual = cabeza[puntajeMaximo];
+    }
+    return orden;
+}
+
+// Devuelve el grafo con los índices permutados: orden[i] es el índice original
+// del nodo que pasa a ocupar la posición i. Las listas de vecinos quedan ordenadas.
+GrafoPlano renumerarGrafo(const GrafoPlano& grafo, const vector<int>& orden) {
+    int n = grafo.numeroNodos();
+    vector<int> nuevoIndice(n);
+    for (int i = 0; i < n; ++i) nuevoIndice[orden[i]] = i;
+
+    GrafoPlano resultado;
+    resultado.nombres.reserve(n);
+    resultado.inicioAdyacencia.assign(n + 1, 0);
+    resultado.vecinos.reserve(grafo.vecinos.size());
+
+    resultado.costos = visit([&](const auto& costos) -> CostosAristas {
+        using Costo = typename decay_t<decltype(costos)>::value_type;
+        vector<Costo> nuevos;
+        nuevos.reserve(costos.size());
+        vector<pair<int, Costo>> fila;
+
+        for (int i = 0; i < n; ++i) {
+            int original = orden[i];
+            resultado.nombres.push_back(grafo.nombres[original]);
+            resultado.indices.emplace(grafo.nombres[original], i);
+
+            fila.clear();
+            for (int e = grafo.inicioAdyacencia[original]; e < grafo.inicioAdyacencia[original + 1]; ++e) {
+                fila.push_back({nuevoIndice[grafo.vecinos[e]], costos[e]});
+            }
+            sort(fila.begin(), fila.end());
+            for (const auto& [vecino, costo] : fila) {
+                resultado.vecinos.push_back(vecino);
+                nuevos.push_back(costo);
+            }
+            resultado.inicioAdyacencia[i + 1] = static_cast<int>(resultado.vecinos.size());
+        }
+        return nuevos;
+    }, grafo.costos);
+    return resultado;
+}
+
+vector<int> calcularOrden(const GrafoPlano& grafo, OrdenEnrutadores criterio) {
+    switch (criterio) {
+        case OrdenEnrutadores::BFS:
+            return ordenEnAnchura(grafo, false);
+        case OrdenEnrutadores::CuthillMcKeeInverso:
+            return ordenEnAnchura(grafo, true);
+        case OrdenEnrutadores::Gorder:
+            return ordenGorder(grafo);
+        case OrdenEnrutadores::Ninguno:
+            break;
+    }
+    vector<int> orden(grafo.numeroNodos());
+    for (int v = 0; v < grafo.numeroNodos(); ++v) orden[v] = v;
+    return orden;
+}
+
+// Tabla de nombres de una red: cada nombre de enrutador se guarda una sola vez
+// y se identifica por un entero. Como el resto de la red, no admite inserciones
+// concurrentes desde varios hilos.
+class InternadorNombres {
+private:
+    deque<string> nombres;                          // deque: las referencias no se invalidan
+    unordered_map<string_view, uint32_t> indices;
+
+public:
+    uint32_t internar(const string& nombre) {
+        auto it = indices.find(nombre);
+        if (it != indices.end()) return it->second;
+        uint32_t id = static_cast<uint32_t>(nombres.size());
+        nombres.push_back(nombre);
+        indices.emplace(nombres.back(), id);
+        return id;
+    }
+
+    // Busca sin insertar; devuelve false si el nombre nunca se ha internado
+    bool buscar(const string& nombre, uint32_t& id) const {
+        auto it = indices.find(nombre);
+        if (it == indices.end()) return false;
+        id = it->second;
+        return true;
+    }
+
+    const string& nombre(uint32_t id) const { return nombres[id]; }
+};
+
+struct Enlace {
+    uint32_t vecino;   // Identificador del nombre internado
+    int costo;
+};
+
+// Arena para las tablas de enlaces de una red que no caben en línea. Reparte
+// bloques de capacidad potencia de dos desde trozos grandes y recicla los
+// liberados en listas libres por clase, sin una reserva del sistema por tabla.
+class ArenaEnlaces {
+private:
+    static constexpr size_t ENLACES_POR_TROZO = 8192;
+    static constexpr int NUM_CLASES = 32;
+
+    vector<unique_ptr<Enlace[]>> trozos;       // Trozos compartidos que se reparten en secuencia
+    vector<unique_ptr<Enlace[]>> dedicados;    // Bloques grandes, uno por tabla
+    Enlace* trozoActual = nullptr;
+    size_t usadosEnTrozo = ENLACES_POR_TROZO;
+    Enlace* libres[NUM_CLASES] = {};   // Lista enlazada guardada dentro de los bloques libres
+
+    static int claseDe(uint32_t capacidad) {
+        int clase = 0;
+        while ((1u << clase) < capacidad) ++clase;
+        return clase;
+    }
+
+public:
+    ArenaEnlaces() = default;
+    ArenaEnlaces(const ArenaEnlaces&) = delete;
+    ArenaEnlaces& operator=(const ArenaEnlaces&) = delete;
+
+    // capacidad debe ser potencia de dos
+    Enlace* reservar(uint32_t capacidad) {
+        int clase = claseDe(capacidad);
+        if (Enlace* bloque = libres[clase]) {
+            memcpy(&libres[clase], bloque, sizeof(Enlace*));
+            return bloque;
+        }
+        if (capacidad > ENLACES_POR_TROZO / 4) {
+            dedicados.emplace_back(new Enlace[capacidad]);
+            return dedicados.back().get();
+        }
+        if (usadosEnTrozo + capacidad > ENLACES_POR_TROZO) {
+            trozos.emplace_back(new Enlace[ENLACES_POR_TROZO]);
+            trozoActual = trozos.back().get();
+            usadosEnTrozo = 0;
+        }
+        Enlace* bloque = trozoActual + usadosEnTrozo;
+        usadosEnTrozo += capacidad;
+        return bloque;
+    }
+
+    void liberar(Enlace* bloque, uint32_t capacidad) {
+        int clase = claseDe(capacidad);
+        memcpy(bloque, &libres[clase], sizeof(Enlace*));
+        libres[clase] = bloque;
+    }
+};
+
+// Nombres y arena de una red. Cada Red tiene el suyo y lo reparte a sus tablas,
+// de modo que al destruirla se libera toda su memoria y dos redes distintas
+// pueden usarse desde hilos distintos. Debe sobrevivir a las tablas que lo usan.
+struct AlmacenEnlaces {
+    InternadorNombres nombres;
+    ArenaEnlaces arena;
+};
+
+// Tabla de enrutamiento compacta: arreglo de (vecino, costo) ordenado por
+// identificador de vecino. Hasta CAPACIDAD_EN_LINEA enlaces viven dentro del
+// propio objeto; las tablas más grandes toman su bloque de la arena del almacén.
+// Los identificadores solo tienen sentido dentro de ese almacén, así que una
+// copia o un movimiento también adoptan el almacén de la tabla de origen.
+class TablaPlana {
+private:
+    static constexpr uint32_t CAPACIDAD_EN_LINEA = 4;
+
+    AlmacenEnlaces* almacen;
+    Enlace* datos;
+    uint32_t tamano = 0;
+    uint32_t capacidad = CAPACIDAD_EN_LINEA;
+    Enlace enLinea[CAPACIDAD_EN_LINEA];
+
+    bool usaArena() const { return datos != enLinea; }
+
+    const Enlace* buscar(uint32_t id) const {
+        const Enlace* it = lower_bound(datos, datos + tamano, id,
+                                       [](const Enlace& e, uint32_t valor) { return e.vecino < valor; });
+        return (it != datos + tamano && it->vecino == id) ? it : nullptr;
+    }
+
+    void crecer() {
+        uint32_t nuevaCapacidad = capacidad * 2;
+        Enlace* nuevos = almacen->arena.reservar(nuevaCapacidad);
+        copy(datos, datos + tamano, nuevos);
+        liberarDatos();
+        datos = nuevos;
+        capacidad = nuevaCapacidad;
+    }
+
+    void liberarDatos() {
+        if (usaArena()) almacen->arena.liberar(datos, capacidad);
+        datos = enLinea;
+        capacidad = CAPACIDAD_EN_LINEA;
+    }
+
+public:
+    class iterator {
+    private:
+        const Enlace* actual;
+        const InternadorNombres* nombres;
+
+    public:
+        iterator(const Enlace* enlace, const InternadorNombres* tablaNombres)
+            : actual(enlace), nombres(tablaNombres) {}
+        pair<const string&, int> operator*() const {
+            return {nombres->nombre(actual->vecino), actual->costo};
+        }
+        iterator& operator++() { ++actual; return *this; }
+        bool operator!=(const iterator& otro) const { return actual != otro.actual; }
+    };
+
+    explicit TablaPlana(AlmacenEnlaces& almacenRed) : almacen(&almacenRed), datos(enLinea) {}
+
+    TablaPlana(const TablaPlana& otra) : TablaPlana(*otra.almacen) { *this = otra; }
+
+    TablaPlana(TablaPlana&& otra) noexcept : TablaPlana(*otra.almacen) { *this = move(otra); }
+
+    TablaPlana& operator=(const TablaPlana& otra) {
+        if (this == &otra) return *this;
+        tamano = 0;
+        if (almacen != otra.almacen) {
+            liberarDatos();
+            almacen = otra.almacen;
+        }
+        while (capacidad < otra.tamano) crecer();
+        copy(otra.datos, otra.datos + otra.tamano, datos);
+        tamano = otra.tamano;
+        return *this;
+    }
+
+    TablaPlana& operator=(TablaPlana&& otra) noexcept {
+        if (this == &otra) return *this;
+        liberarDatos();
+        almacen = otra.almacen;
+        if (otra.usaArena()) {
+            datos = otra.datos;
+            capacidad = otra.capacidad;
+            otra.datos = otra.enLinea;
+            otra.capacidad = CAPACIDAD_EN_LINEA;
+        } else {
+            copy(otra.datos, otra.datos + otra.tamano, enLinea);
+        }
+        tamano = otra.tamano;
+        otra.tamano = 0;
+        return *this;
+    }
+
+    ~TablaPlana() { liberarDatos(); }
+
+    void actualizar(const string& destino, int costo) {
+        uint32_t id = almacen->nombres.internar(destino);
+        Enlace* it = lower_bound(datos, datos + tamano, id,
+                                 [](const Enlace& e, uint32_t valor) { return e.vecino < valor; });
+        if (it != datos + tamano && it->vecino == id) {
+            it->costo = costo;
+            return;
+        }
+        size_t posicion = it - datos;
+        if (tamano == capacidad) crecer();
+        copy_backward(datos + posicion, datos + tamano, datos + tamano + 1);
+        datos[posicion] = {id, costo};
+        ++tamano;
+    }
+
+    // Devuelve true si el enlace existía
+    bool eliminar(const string& destino) {
+        uint32_t id;
+        if (!almacen->nombres.buscar(destino, id)) return false;
+        const Enlace* it = buscar(id);
+        if (!it) return false;
+        size_t posicion = it - datos;
+        copy(datos + posicion + 1, datos + tamano, datos + posicion);
+        --tamano;
+        return true;
+    }
+
+    int costo(const string& destino) const {
+        uint32_t id;
+        if (!almacen->nombres.buscar(destino, id)) return DISTANCIA_INFINITA;
+        return costoPorId(id);
+    }
+
+    // Consulta directa por nombre internado, sin pasar por la tabla de nombres
+    int costoPorId(uint32_t id) const {
+        const Enlace* it = buscar(id);
+        return it ? it->costo : DISTANCIA_INFINITA;
+    }
+
+    AlmacenEnlaces& obtenerAlmacen() const { return *almacen; }
+
+    size_t size() const { return tamano; }
+    iterator begin() const { return iterator(datos, &almacen->nombres); }
+    iterator end() const { return iterator(datos + tamano, &almacen->nombres); }
+};
+
+// Tabla de enrutamiento basada en unordered_map (implementación original)
+class TablaHash {
+private:
+    AlmacenEnlaces* almacen;  // Solo para el nombre del enrutador: las claves son cadenas
+    unordered_map<string, int> enlaces;
+
+public:
+    explicit TablaHash(AlmacenEnlaces& almacenRed) : almacen(&almacenRed) {}
+
+    void actualizar(const string& destino, int costo) { enlaces[destino] = costo; }
+
+    bool eliminar(const string& destino) { return enlaces.erase(destino) > 0; }
+
+    int costo(const string& destino) const {
+        auto it = enlaces.find(destino);
+        return (it != enlaces.end()) ? it->second : DISTANCIA_INFINITA;
+    }
+
+    AlmacenEnlaces& obtenerAlmacen() const { return *almacen; }
+
+    size_t size() const { return enlaces.size(); }
+    auto begin() const { return enlaces.begin(); }
+    auto end() const { return enlaces.end(); }
+};
+
+// Compilar con -DENRUTADOR_TABLA_HASH para volver a la tabla basada en unordered_map
+#ifdef ENRUTADOR_TABLA_HASH
+using TablaEnlaces = TablaHash;
+#else
+using TablaEnlaces = TablaPlana;
+#endif
+
+// Lote de cambios sobre la red que se valida y aplica de una sola vez con
+// Red::confirmarTransaccion. Si alguna operación es inválida no se aplica ninguna.
+class TransaccionRed {
+public:
+    enum class Tipo {
+        AgregarEnrutador,
+        EliminarEnrutador,
+        AgregarEnlace,     // Crea los enrutadores que falten; si el enlace existe, cambia su costo
+        CambiarCosto,      // El enlace debe existir
+        EliminarEnlace     // El enlace debe existir
+    };
+
+    struct Operacion {
+        Tipo tipo;
+        string origen;
+        string destino;
+        int costo;
+    };
+
+private:
+    vector<Operacion> pendientes;
+
+public:
+    TransaccionRed& agregarEnrutador(const string& nombre) {
+        pendientes.push_back({Tipo::AgregarEnrutador, nombre, "", 0});
+        return *this;
+    }
+
+    TransaccionRed& eliminarEnrutador(const string& nombre) {
+        pendientes.push_back({Tipo::EliminarEnrutador, nombre, "", 0});
+        return *this;
+    }
+
+    TransaccionRed& agregarEnlace(const string& origen, const string& destino, int costo) {
+        pendientes.push_back({Tipo::AgregarEnlace, origen, destino, costo});
+        return *this;
+    }
+
+    TransaccionRed& cambiarCosto(const string& origen, const string& destino, int costo) {
+        pendientes.push_back({Tipo::CambiarCosto, origen, destino, costo});
+        return *this;
+    }
+
+    TransaccionRed& eliminarEnlace(const string& origen, const string& destino) {
+        pendientes.push_back({Tipo::EliminarEnlace, origen, destino, 0});
+        return *this;
+    }
+
+    const vector<Operacion>& operaciones() const { return pendientes; }
+    size_t size() const { return pendientes.size(); }
+    bool empty() const { return pendientes.empty(); }
+    void limpiar() { pendientes.clear(); }
+};
+
+// ctime devuelve un búfer estático del proceso: se serializa para que redes
+// distintas puedan registrar cambios desde hilos distintos
+string marcaDeTiempoActual() {
+    static mutex mutexCtime;
+    auto tiempo = chrono::system_clock::to_time_t(chrono::system_clock::now());
+    lock_guard<mutex> bloqueo(mutexCtime);
+    return ctime(&tiempo);
+}
+
+// Cambio sobre la tabla de un enrutador; un costo negativo elimina la ruta
+struct CambioRuta {
+    string destino;
+    int costo;
+};
+
 class Enrutador {
 private:
-    unordered_map<string, int> tablaEnrutamiento;
-    string nombre;
+    TablaEnlaces tablaEnrutamiento;
+    uint32_t idNombre;  // Nombre internado en el almacén de la red
     chrono::system_clock::time_point ultimaActualizacion;
     vector<string> historialCambios;
 
+    // En redes muy grandes el historial por enrutador domina la memoria
+    static inline bool historialDetallado = true;
+
 public:
-    explicit Enrutador(const string& nombreEnrutador = "") : 
-        nombre(nombreEnrutador), 
+    Enrutador(const string& nombreEnrutador, AlmacenEnlaces& almacen) : 
+        tablaEnrutamiento(almacen),
+        idNombre(almacen.nombres.internar(nombreEnrutador)), 
         ultimaActualizacion(chrono::system_clock::now()) {}
 
+    // Activa o desactiva el historial de cambios de todos los enrutadores
+    static void establecerHistorialDetallado(bool activo) { historialDetallado = activo; }
+    static bool obtenerHistorialDetallado() { return historialDetallado; }
+
     // Getters y setters mejorados
     void establecerNombre(const string& nombreEnrutador) {
         if (nombreEnrutador.empty()) {
             throw invalid_argument("El nombre del enrutador no puede estar vacío");
         }
-        nombre = nombreEnrutador;
+        idNombre = tablaEnrutamiento.obtenerAlmacen().nombres.internar(nombreEnrutador);
         registrarCambio("Cambio de nombre a: " + nombreEnrutador);
     }
 
-    const string& obtenerNombre() const { return nombre; }
+    const string& obtenerNombre() const { return tablaEnrutamiento.obtenerAlmacen().nombres.nombre(idNombre); }
 
     void actualizarRuta(const string& destino, int costo) {
         if (costo < 0) {
             throw invalid_argument("El costo no puede ser negativo");
         }
-        tablaEnrutamiento[destino] = costo;
+        tablaEnrutamiento.actualizar(destino, costo);
         ultimaActualizacion = chrono::system_clock::now();
         registrarCambio("Actualización de ruta a " + destino + " con costo " + to_string(costo));
     }
 
     void eliminarRuta(const string& destino) {
-        auto it = tablaEnrutamiento.find(destino);
-        if (it != tablaEnrutamiento.end()) {
-            tablaEnrutamiento.erase(it);
+        if (tablaEnrutamiento.eliminar(destino)) {
             registrarCambio("Eliminación de ruta a " + destino);
         }
     }
 
+    // Aplica varios cambios seguidos con una sola entrada en el historial
+    void aplicarCambiosRuta(const CambioRuta* inicio, const CambioRuta* fin) {
+        for (const CambioRuta* cambio = inicio; cambio != fin; ++cambio) {
+            if (cambio->costo < 0) tablaEnrutamiento.eliminar(cambio->destino);
+            else tablaEnrutamiento.actualizar(cambio->destino, cambio->costo);
+        }
+        ultimaActualizacion = chrono::system_clock::now();
+        registrarCambio("Aplicados " + to_string(fin - inicio) + " cambios de ruta en lote");
+    }
+
     int obtenerCosto(const string& destino) const {
-        auto it = tablaEnrutamiento.find(destino);
-        return (it != tablaEnrutamiento.end()) ? it->second : numeric_limits<int>::max();
+        return tablaEnrutamiento.costo(destino);
     }
 
-    const unordered_map<string, int>& obtenerTablaEnrutamiento() const {
+    const TablaEnlaces& obtenerTablaEnrutamiento() const {
         return tablaEnrutamiento;
     }
 
@@ -90,17 +885,29 @@ public:
 
 private:
     void registrarCambio(const string& cambio) {
-        auto tiempo = chrono::system_clock::to_time_t(chrono::system_clock::now());
-        historialCambios.push_back(string(ctime(&tiempo)) + ": " + cambio);
+        if (!historialDetallado) return;
+        historialCambios.push_back(marcaDeTiempoActual() + ": " + cambio);
     }
 };
 
 class Red {
 private:
+    // Declarado antes que los enrutadores para que se destruya después de ellos
+    unique_ptr<AlmacenEnlaces> almacen = make_unique<AlmacenEnlaces>();
     unordered_map<string, Enrutador> enrutadores;
     vector<string> historialCambios;
     chrono::system_clock::time_point creacion;
 
+    // Estado derivado: se descarta con cada cambio y se reconstruye bajo demanda
+    mutable mutex mutexDerivado;
+    mutable shared_ptr<GrafoPlano> grafoPlano;
+    mutable shared_ptr<const IndiceLandmarks> indiceLandmarks;
+    mutable unique_ptr<EstadisticasRed> estadisticas;
+    mutable int conectada = -1;  // -1 = sin calcular
+    OrdenEnrutadores ordenEnrutadores = OrdenEnrutadores::Ninguno;
+    int numLandmarks = 0;  // 0 = modo landmarks desactivado
+    SeleccionLandmarks seleccionLandmarks = SeleccionLandmarks::MasLejano;
+
 public:
     Red() : creacion(chrono::system_clock::now()) {}
 
@@ -115,7 +922,8 @@ public:
         if (existeEnrutador(nombre)) {
             throw invalid_argument("Ya existe un enrutador con ese nombre");
         }
-        enrutadores.emplace(nombre, Enrutador(nombre));
+        enrutadores.emplace(nombre, Enrutador(nombre, *almacen));
+        invalidarEstadoDerivado();
         registrarCambio("Agregado nuevo enrutador: " + nombre);
     }
 
@@ -127,6 +935,7 @@ public:
         for (auto& [_, enrutador] : enrutadores) {
             enrutador.eliminarRuta(nombre);
         }
+        invalidarEstadoDerivado();
         registrarCambio("Eliminado enrutador: " + nombre);
     }
 
@@ -139,9 +948,125 @@ public:
         }
         enrutadores.at(origen).actualizarRuta(destino, costo);
         enrutadores.at(destino).actualizarRuta(origen, costo);
+        invalidarEstadoDerivado();
         registrarCambio("Actualizado enlace " + origen + " <-> " + destino + " con costo " + to_string(costo));
     }
 
+    // Valida todas las operaciones de la transacción contra el estado que irían
+    // produciendo y, solo si todas son válidas, las aplica en una pasada agrupada
+    // por enrutador. El estado derivado se invalida una única vez al final.
+    void confirmarTransaccion(const TransaccionRed& transaccion) {
+        using Tipo = TransaccionRed::Tipo;
+
+        // Estado simulado: enrutadores tocados y costo final de cada enlace (-1 = eliminado)
+        unordered_map<string, bool> existe;
+        unordered_set<string> eliminados;
+        map<pair<string, string>, int> enlaces;
+
+        auto existeSimulado = [&](const string& nombre) {
+            auto it = existe.find(nombre);
+            return it != existe.end() ? it->second : existeEnrutador(nombre);
+        };
+        auto clave = [](const string& a, const string& b) { return a < b ? make_pair(a, b) : make_pair(b, a); };
+        auto costoSimulado = [&](const string& a, const string& b) {
+            auto it = enlaces.find(clave(a, b));
+            if (it != enlaces.end()) return it->second;
+            // Un enlace previo desaparece si alguno de sus extremos se eliminó en la transacción
+            if (eliminados.count(a) || eliminados.count(b) || !existeEnrutador(a)) return -1;
+            int costo = enrutadores.at(a).obtenerCosto(b);
+            return costo == DISTANCIA_INFINITA ? -1 : costo;
+        };
+
+        const auto& operaciones = transaccion.operaciones();
+        for (size_t i = 0; i < operaciones.size(); ++i) {
+            const auto& op = operaciones[i];
+            auto fallar = [&](const string& motivo) {
+                throw invalid_argument("Operación " + to_string(i + 1) + " de la transacción: " + motivo);
+            };
+
+            switch (op.tipo) {
+                case Tipo::AgregarEnrutador:
+                    if (op.origen.empty()) fallar("El nombre del enrutador no puede estar vacío");
+                    if (existeSimulado(op.origen)) fallar("Ya existe un enrutador con ese nombre");
+                    existe[op.origen] = true;
+                    break;
+                case Tipo::EliminarEnrutador:
+                    if (!existeSimulado(op.origen)) fallar("Enrutador no encontrado");
+                    existe[op.origen] = false;
+                    eliminados.insert(op.origen);
+                    for (auto it = enlaces.begin(); it != enlaces.end(); ++it) {
+                        if (it->first.first == op.origen || it->first.second == op.origen) it->second = -1;
+                    }
+                    break;
+                case Tipo::AgregarEnlace:
+                    if (op.origen.empty() || op.destino.empty()) fallar("El nombre del enrutador no puede estar vacío");
+                    if (op.costo < 0) fallar("El costo no puede ser negativo");
+                    existe[op.origen] = true;
+                    existe[op.destino] = true;
+                    enlaces[clave(op.origen, op.destino)] = op.costo;
+                    break;
+                case Tipo::CambiarCosto:
+                case Tipo::EliminarEnlace:
+                    if (!existeSimulado(op.origen) || !existeSimulado(op.destino)) {
+                        fallar("Enrutador origen o destino no existe");
+                    }
+                    if (costoSimulado(op.origen, op.destino) < 0) {
+                        fallar("No existe enlace entre " + op.origen + " y " + op.destino);
+                    }
+                    if (op.tipo == Tipo::CambiarCosto && op.costo < 0) fallar("El costo no puede ser negativo");
+                    enlaces[clave(op.origen, op.destino)] = op.tipo == Tipo::CambiarCosto ? op.costo : -1;
+                    break;
+            }
+        }
+
+        // A partir de aquí todas las operaciones son válidas: se aplica el efecto neto
+        for (const auto& nombre : eliminados) {
+            auto it = enrutadores.find(nombre);
+            if (it == enrutadores.end()) continue;
+            for (const auto& [vecino, _] : it->second.obtenerTablaEnrutamiento()) {
+                if (vecino != nombre) enrutadores.at(vecino).eliminarRuta(nombre);
+            }
+            enrutadores.erase(it);
+        }
+        vector<string> creados;
+        for (const auto& [nombre, existeAlFinal] : existe) {
+            if (existeAlFinal && !existeEnrutador(nombre)) {
+                enrutadores.emplace(nombre, Enrutador(nombre, *almacen));
+                creados.push_back(nombre);
+            }
+        }
+
+        // Cambios por enrutador, ordenados por su posición en memoria para recorrerlos en secuencia
+        vector<pair<Enrutador*, CambioRuta>> cambios;
+        cambios.reserve(enlaces.size() * 2);
+        for (const auto& [extremos, costo] : enlaces) {
+            const auto& [a, b] = extremos;
+            if (!existeEnrutador(a) || !existeEnrutador(b)) continue;
+            cambios.push_back({&enrutadores.at(a), {b, costo}});
+            if (a != b) cambios.push_back({&enrutadores.at(b), {a, costo}});
+        }
+        sort(cambios.begin(), cambios.end(),
+             [](const auto& x, const auto& y) { return x.first < y.first; });
+
+        vector<CambioRuta> grupo;
+        for (size_t i = 0; i < cambios.size();) {
+            size_t j = i;
+            grupo.clear();
+            while (j < cambios.size() && cambios[j].first == cambios[i].first) {
+                grupo.push_back(move(cambios[j].second));
+                ++j;
+            }
+            cambios[i].first->aplicarCambiosRuta(grupo.data(), grupo.data() + grupo.size());
+            i = j;
+        }
+
+        bool soloCostos = all_of(operaciones.begin(), operaciones.end(),
+                                 [](const auto& op) { return op.tipo == Tipo::CambiarCosto; });
+        if (soloCostos) repararCostosDerivados(enlaces);
+        else repararEstructuraDerivada(eliminados, creados, enlaces);
+        registrarCambio("Transacción confirmada: " + to_string(operaciones.size()) + " operaciones");
+    }
+
     void cargarTopologiaDesdeArchivo(const string& nombreArchivo) {
         ifstream archivo(nombreArchivo);
         if (!archivo) {
@@ -150,6 +1075,8 @@ public:
 
         // Limpiamos la red actual
         enrutadores.clear();
+        almacen = make_unique<AlmacenEnlaces>();
+        invalidarEstadoDerivado();
         registrarCambio("Iniciando carga de topología desde archivo: " + nombreArchivo);
 
         string linea;
@@ -184,52 +1111,265 @@ public:
                        to_string(enlacesCargados) + " enlaces");
     }
 
+    // Aplica un archivo de cambios sobre la red actual sin recargarla. Formato:
+    //   + A B costo   agrega el enlace (crea los enrutadores que falten)
+    //   - A B         elimina el enlace
+    //   - A           elimina el enrutador
+    //   ~ A B costo   cambia el costo de un enlace existente
+    // Primero se recorre todo el archivo validando solo el formato, así que una
+    // línea mal escrita no aplica nada. Luego se procesa en lotes de lineasPorLote
+    // operaciones; cada lote es una transacción, y un error semántico (por ejemplo,
+    // un enlace inexistente) deja aplicados los lotes anteriores de forma intencional:
+    // validarlo todo de antemano exigiría mantener el archivo completo en memoria.
+    void aplicarDeltaDesdeArchivo(const string& nombreArchivo, size_t lineasPorLote = 4096) {
+        ifstream archivo(nombreArchivo);
+        if (!archivo) {
+            throw runtime_error("No se pudo abrir el archivo: " + nombreArchivo);
+        }
+
+        // Agrega a la transacción la operación de la línea; false si el formato es inválido
+        auto interpretarLinea = [](const string& linea, TransaccionRed& transaccion) {
+            stringstream ss(linea);
+            string operacion, origen, extremo;
+            int costo;
+            ss >> operacion >> origen;
+
+            if (operacion == "+" && ss >> extremo >> costo) {
+                transaccion.agregarEnlace(origen, extremo, costo);
+            } else if (operacion == "~" && ss >> extremo >> costo) {
+                transaccion.cambiarCosto(origen, extremo, costo);
+            } else if (operacion == "-" && !origen.empty()) {
+                if (ss >> extremo) transaccion.eliminarEnlace(origen, extremo);
+                else transaccion.eliminarEnrutador(origen);
+            } else {
+                return false;
+            }
+            return true;
+        };
+
+        TransaccionRed lote;
+        string linea;
+        int numLinea = 0;
+
+        while (getline(archivo, linea)) {
+            numLinea++;
+            if (linea.empty() || linea[0] == '#') continue;
+            if (!interpretarLinea(linea, lote)) {
+                throw runtime_error("Error en formato de línea " + to_string(numLinea));
+            }
+            lote.limpiar();
+        }
+        archivo.clear();
+        archivo.seekg(0);
+
+        numLinea = 0;
+        int primeraLineaLote = 1;
+        int operacionesAplicadas = 0;
+
+        auto confirmarLote = [&]() {
+            if (lote.empty()) return;
+            try {
+                confirmarTransaccion(lote);
+            } catch (const exception& e) {
+                throw runtime_error("Error en líneas " + to_string(primeraLineaLote) + "-" +
+                                    to_string(numLinea) + ": " + e.what());
+            }
+            operacionesAplicadas += static_cast<int>(lote.size());
+            lote.limpiar();
+            primeraLineaLote = numLinea + 1;
+        };
+
+        while (getline(archivo, linea)) {
+            numLinea++;
+            if (linea.empty() || linea[0] == '#') continue;
+            interpretarLinea(linea, lote);
+
+            if (lote.size() >= lineasPorLote) confirmarLote();
+        }
+        confirmarLote();
+
+        registrarCambio("Cambios aplicados desde " + nombreArchivo + ": " +
+                        to_string(operacionesAplicadas) + " operaciones");
+    }
+
+    // Ruta más corta como VistaRuta: sin copias de nombres ni reservas de memoria por consulta
+    VistaRuta consultarRuta(const string& origen, const string& destino) const {
+        if (!existeEnrutador(origen) || !existeEnrutador(destino)) {
+            throw invalid_argument("Enrutador origen o destino no existe");
+        }
+        auto grafo = obtenerGrafoPlano();
+        int s = grafo->indices.at(origen);
+        int t = grafo->indices.at(destino);
+        return buscarRuta(move(grafo), s, t);
+    }
+
     pair<int, vector<string>> encontrarRutaMasCorta(const string& origen, const string& destino) const {
+        auto ruta = consultarRuta(origen, destino);
+        if (!ruta.existe() || ruta.costo() >= static_cast<uint64_t>(DISTANCIA_INFINITA)) {
+            return {-1, {}};
+        }
+        return {static_cast<int>(ruta.costo()), ruta.materializar()};
+    }
+
+    // Criterio de numeración usado al construir el grafo plano de consultas
+    void establecerOrdenEnrutadores(OrdenEnrutadores orden) {
+        {
+            lock_guard<mutex> bloqueo(mutexDerivado);
+            ordenEnrutadores = orden;
+        }
+        invalidarEstadoDerivado();
+    }
+
+    OrdenEnrutadores obtenerOrdenEnrutadores() const {
+        lock_guard<mutex> bloqueo(mutexDerivado);
+        return ordenEnrutadores;
+    }
+
+    // Representación plana vigente; se construye si la red cambió desde la última consulta
+    shared_ptr<const GrafoPlano> obtenerGrafoPlano() const {
+        lock_guard<mutex> bloqueo(mutexDerivado);
+        return obtenerGrafoPlanoSinBloqueo();
+    }
+
+    // Costo de la ruta más corta acumulado en el tipo indicado. Con la variante
+    // ancha (uint64_t, por defecto) la suma no se satura aunque exceda el rango de int.
+    // Devuelve costoInfinito<Distancia>() si no hay ruta.
+    template <typename Distancia = uint64_t>
+    Distancia calcularCostoAcumulado(const string& origen, const string& destino) const {
         if (!existeEnrutador(origen) || !existeEnrutador(destino)) {
             throw invalid_argument("Enrutador origen o destino no existe");
         }
+        auto grafo = obtenerGrafoPlano();
+        vector<Distancia> distancias;
+        calcularDistanciasDesde(*grafo, grafo->indices.at(origen), distancias);
+        return distancias[grafo->indices.at(destino)];
+    }
 
-        unordered_map<string, int> distancias;
-        unordered_map<string, string> anterior;
-        priority_queue<pair<int, string>, vector<pair<int, string>>, greater<>> cola;
+    // Activa el modo landmarks: escoge k landmarks y precalcula sus distancias.
+    // Tras cualquier cambio en la red el índice se reconstruye en la siguiente consulta.
+    void activarLandmarks(int k, SeleccionLandmarks seleccion = SeleccionLandmarks::MasLejano) {
+        if (k <= 0) {
+            throw invalid_argument("El número de landmarks debe ser positivo");
+        }
+        {
+            lock_guard<mutex> bloqueo(mutexDerivado);
+            numLandmarks = k;
+            seleccionLandmarks = seleccion;
+            indiceLandmarks.reset();
+        }
+        auto indice = obtenerIndiceLandmarks();
+        registrarCambio("Activados " + to_string(indice->k) + " landmarks");
+    }
 
-        // Inicialización
-        for (const auto& [nombre, _] : enrutadores) {
-            distancias[nombre] = numeric_limits<int>::max();
+    void desactivarLandmarks() {
+        lock_guard<mutex> bloqueo(mutexDerivado);
+        numLandmarks = 0;
+        indiceLandmarks.reset();
+    }
+
+    bool landmarksActivos() const { return numLandmarks > 0; }
+
+    // Cotas inferior y superior del costo en O(k) usando la desigualdad triangular
+    CotasCosto estimarCosto(const string& origen, const string& destino) const {
+        if (!existeEnrutador(origen) || !existeEnrutador(destino)) {
+            throw invalid_argument("Enrutador origen o destino no existe");
+        }
+        auto indice = obtenerIndiceLandmarks();
+        const auto& grafo = *indice->grafo;
+        int u = grafo.indices.at(origen);
+        int v = grafo.indices.at(destino);
+        if (u == v) return {0, 0, true};
+
+        const int* du = indice->filaDe(u);
+        const int* dv = indice->filaDe(v);
+
+        // Bucle sin saltos sobre carriles de 32 bits: las condiciones se aplican como
+        // máscaras de bits y solo quedan reducciones max/min/or, de modo que GCC lo
+        // vectoriza con -O3 (comprobado con -fopt-info-vec)
+        int inferior = 0;
+        uint32_t superior = numeric_limits<uint32_t>::max();
+        int separados = 0;
+        for (int i = 0; i < indice->k; ++i) {
+            int a = du[i];
+            int b = dv[i];
+            int finitoA = a != DISTANCIA_INFINITA;
+            int finitoB = b != DISTANCIA_INFINITA;
+            separados |= finitoA ^ finitoB;
+            int diferencia = a > b ? a - b : b - a;
+            inferior = max(inferior, diferencia & -(finitoA & finitoB));
+            // Una distancia recortada a TOPE solo sirve como cota inferior; dos
+            // distancias exactas suman menos de 2^32; si alguna no lo es, la
+            // máscara lleva la suma a todo unos y no cuenta
+            int exactos = (a < IndiceLandmarks::TOPE) & (b < IndiceLandmarks::TOPE);
+            uint32_t suma = static_cast<uint32_t>(a) + static_cast<uint32_t>(b);
+            superior = min(superior, suma | static_cast<uint32_t>(exactos - 1));
         }
-        distancias[origen] = 0;
-        cola.push({0, origen});
 
-        while (!cola.empty()) {
-            auto [dist, actual] = cola.top();
-            cola.pop();
+        if (separados) return {-1, -1, false};
+        return {inferior, static_cast<int>(min<uint32_t>(superior, DISTANCIA_INFINITA)), true};
+    }
 
-            if (actual == destino) break;
-            if (dist > distancias[actual]) continue;
+    // Ruta exacta con A* usando los landmarks como heurística (ALT)
+    pair<int, vector<string>> encontrarRutaMasCortaALT(const string& origen, const string& destino) const {
+        if (!existeEnrutador(origen) || !existeEnrutador(destino)) {
+            throw invalid_argument("Enrutador origen o destino no existe");
+        }
+        auto indice = obtenerIndiceLandmarks();
+        const auto& grafo = *indice->grafo;
+        int s = grafo.indices.at(origen);
+        int t = grafo.indices.at(destino);
+        const int* dt = indice->filaDe(t);
+
+        // Cota inferior de d(v, t); DISTANCIA_INFINITA si v no puede llegar a t
+        auto heuristica = [&](int v) {
+            const int* dv = indice->filaDe(v);
+            int h = 0;
+            for (int i = 0; i < indice->k; ++i) {
+                bool finitoV = dv[i] != DISTANCIA_INFINITA;
+                bool finitoT = dt[i] != DISTANCIA_INFINITA;
+                if (finitoV != finitoT) return DISTANCIA_INFINITA;
+                if (finitoV) h = max(h, abs(dv[i] - dt[i]));
+            }
+            return h;
+        };
 
-            const auto& enrutadorActual = enrutadores.at(actual);
-            for (const auto& [vecino, costo] : enrutadorActual.obtenerTablaEnrutamiento()) {
-                int nuevaDist = dist + costo;
-                if (nuevaDist < distancias[vecino]) {
-                    distancias[vecino] = nuevaDist;
-                    anterior[vecino] = actual;
-                    cola.push({nuevaDist, vecino});
+        vector<int> distancias(grafo.numeroNodos(), DISTANCIA_INFINITA);
+        vector<int> anterior(grafo.numeroNodos(), -1);
+        priority_queue<pair<long long, int>, vector<pair<long long, int>>, greater<>> cola;
+        distancias[s] = 0;
+        cola.push({heuristica(s), s});
+
+        visit([&](const auto& costos) {
+            while (!cola.empty()) {
+                auto [prioridad, actual] = cola.top();
+                cola.pop();
+                if (actual == t) break;
+                if (prioridad > static_cast<long long>(distancias[actual]) + heuristica(actual)) continue;
+
+                for (int e = grafo.inicioAdyacencia[actual]; e < grafo.inicioAdyacencia[actual + 1]; ++e) {
+                    int vecino = grafo.vecinos[e];
+                    int nuevaDist = sumaSaturada(distancias[actual], static_cast<int>(costos[e]));
+                    if (nuevaDist < distancias[vecino]) {
+                        int h = heuristica(vecino);
+                        if (h == DISTANCIA_INFINITA) continue;
+                        distancias[vecino] = nuevaDist;
+                        anterior[vecino] = actual;
+                        cola.push({static_cast<long long>(nuevaDist) + h, vecino});
+                    }
                 }
             }
-        }
+        }, grafo.costos);
 
         vector<string> ruta;
-        if (distancias[destino] == numeric_limits<int>::max()) {
+        if (distancias[t] == DISTANCIA_INFINITA) {
             return {-1, ruta};
         }
-
-        for (string actual = destino; actual != origen; actual = anterior.at(actual)) {
-            ruta.push_back(actual);
+        for (int actual = t; actual != -1; actual = anterior[actual]) {
+            ruta.push_back(grafo.nombres[actual]);
         }
-        ruta.push_back(origen);
         reverse(ruta.begin(), ruta.end());
 
-        return {distancias[destino], ruta};
+        return {distancias[t], ruta};
     }
 
     void generarRedAleatoria(int numEnrutadores, int costoMaximo, double densidad = 0.6) {
@@ -238,6 +1378,8 @@ public:
         }
 
         enrutadores.clear();
+        almacen = make_unique<AlmacenEnlaces>();
+        invalidarEstadoDerivado();
         registrarCambio("Iniciando generación de red aleatoria");
 
         // Crear enrutadores
@@ -251,44 +1393,358 @@ public:
             actualizarEnlace("E" + to_string(i), "E" + to_string(i + 1), costo);
         }
 
-        // Agregar enlaces adicionales según la densidad
-        int enlacesMaximos = (numEnrutadores * (numEnrutadores - 1)) / 2;
-        int enlacesObjetivo = static_cast<int>(enlacesMaximos * densidad);
-        int enlacesActuales = numEnrutadores - 1;
+        // Agregar enlaces adicionales según la densidad
+        int enlacesMaximos = (numEnrutadores * (numEnrutadores - 1)) / 2;
+        int enlacesObjetivo = static_cast<int>(enlacesMaximos * densidad);
+        int enlacesActuales = numEnrutadores - 1;
+
+        while (enlacesActuales < enlacesObjetivo) {
+            int i = rand() % numEnrutadores;
+            int j = rand() % numEnrutadores;
+            string origen = "E" + to_string(i);
+            string destino = "E" + to_string(j);
+
+            if (i != j && enrutadores.at(origen).obtenerCosto(destino) == numeric_limits<int>::max()) {
+                int costo = rand() % costoMaximo + 1;
+                actualizarEnlace(origen, destino, costo);
+                enlacesActuales++;
+            }
+        }
+
+        registrarCambio("Red aleatoria generada con " + to_string(enlacesActuales) + " enlaces");
+    }
+
+    void imprimirRed() const {
+        cout << "\n=== Estado Actual de la Red ===\n";
+        cout << "Número total de enrutadores: " << enrutadores.size() << "\n\n";
+
+        for (const auto& [nombreEnrutador, enrutador] : enrutadores) {
+            cout << "Enrutador " << nombreEnrutador << ":\n";
+            cout << "  Grado: " << enrutador.obtenerGrado() << " conexiones\n";
+            cout << "  Enlaces:\n";
+            
+            for (const auto& [vecino, costo] : enrutador.obtenerTablaEnrutamiento()) {
+                cout << "    -> " << setw(5) << vecino << " | Costo: " << setw(3) << costo << "\n";
+            }
+            cout << "\n";
+        }
+    }
+
+    EstadisticasRed obtenerEstadisticas() const {
+        lock_guard<mutex> bloqueo(mutexDerivado);
+        if (!estadisticas) estadisticas = make_unique<EstadisticasRed>(calcularEstadisticas());
+        return *estadisticas;
+    }
+
+    // Verifica si todos los enrutadores pueden comunicarse entre sí
+    bool esRedConectada() const {
+        lock_guard<mutex> bloqueo(mutexDerivado);
+        if (conectada == -1) {
+            auto grafo = obtenerGrafoPlanoSinBloqueo();
+            // En 64 bits una ruta más larga que INT_MAX no se confunde con "sin ruta"
+            vector<uint64_t> distancias;
+            if (grafo->numeroNodos() > 0) calcularDistanciasDesde(*grafo, 0, distancias);
+            conectada = none_of(distancias.begin(), distancias.end(),
+                                [](uint64_t d) { return d == costoInfinito<uint64_t>(); });
+        }
+        return conectada == 1;
+    }
+
+    void imprimirEstadisticas() const {
+        auto stats = obtenerEstadisticas();
+        cout << "\n=== Estadísticas de la Red ===\n";
+        cout << "Total de enrutadores: " << stats.totalEnrutadores << "\n";
+        cout << "Total de enlaces: " << stats.totalEnlaces << "\n";
+        cout << "Costo promedio: " << fixed << setprecision(2) << stats.costoPromedio << "\n";
+        cout << "Costo mínimo: " << stats.costoMinimo << "\n";
+        cout << "Costo máximo: " << stats.costoMaximo << "\n";
+        cout << "Grado máximo: " << stats.gradoMaximo << "\n";
+        cout << "Red conectada: " << (esRedConectada() ? "Sí" : "No") << "\n";
+    }
+
+    void imprimirHistorial() const {
+        cout << "\n=== Historial de Cambios en la Red ===\n";
+        for (const auto& cambio : historialCambios) {
+            cout << cambio << "\n";
+        }
+    }
+
+private:
+    void invalidarEstadoDerivado() {
+        lock_guard<mutex> bloqueo(mutexDerivado);
+        grafoPlano.reset();
+        indiceLandmarks.reset();
+        estadisticas.reset();
+        conectada = -1;
+    }
+
+    shared_ptr<const GrafoPlano> obtenerGrafoPlanoSinBloqueo() const {
+        if (grafoPlano) return grafoPlano;
+
+        auto grafo = make_shared<GrafoPlano>();
+        grafo->nombres.reserve(enrutadores.size());
+        for (const auto& [nombre, _] : enrutadores) {
+            grafo->indices.emplace(nombre, static_cast<int>(grafo->nombres.size()));
+            grafo->nombres.push_back(nombre);
+        }
+
+        // El ancho de los costos se elige según el mayor costo presente
+        int costoMaximo = 0;
+        for (const auto& [_, enrutador] : enrutadores) {
+            for (const auto& [__, costo] : enrutador.obtenerTablaEnrutamiento()) {
+                costoMaximo = max(costoMaximo, costo);
+            }
+        }
+        grafo->costos = costosParaMaximo(costoMaximo);
+
+        grafo->inicioAdyacencia.assign(grafo->nombres.size() + 1, 0);
+        visit([&](auto& costos) {
+            using Costo = typename decay_t<decltype(costos)>::value_type;
+            for (size_t v = 0; v < grafo->nombres.size(); ++v) {
+                const auto& tabla = enrutadores.at(grafo->nombres[v]).obtenerTablaEnrutamiento();
+                grafo->inicioAdyacencia[v + 1] = grafo->inicioAdyacencia[v] + static_cast<int>(tabla.size());
+                for (const auto& [vecino, costo] : tabla) {
+                    grafo->vecinos.push_back(grafo->indices.at(vecino));
+                    costos.push_back(static_cast<Costo>(costo));
+                }
+            }
+        }, grafo->costos);
+
+        if (ordenEnrutadores != OrdenEnrutadores::Ninguno) {
+            *grafo = renumerarGrafo(*grafo, calcularOrden(*grafo, ordenEnrutadores));
+        }
+
+        grafoPlano = grafo;
+        return grafoPlano;
+    }
 
-        while (enlacesActuales < enlacesObjetivo) {
-            int i = rand() % numEnrutadores;
-            int j = rand() % numEnrutadores;
-            string origen = "E" + to_string(i);
-            string destino = "E" + to_string(j);
+    // Si solo cambiaron costos, la estructura del grafo plano (y su numeración)
+    // sigue siendo válida: se corrigen los costos en lugar de reconstruirlo.
+    // La conectividad no cambia; los landmarks y las estadísticas sí dependen de los costos.
+    void repararCostosDerivados(const map<pair<string, string>, int>& costos) {
+        lock_guard<mutex> bloqueo(mutexDerivado);
+        indiceLandmarks.reset();
+        estadisticas.reset();
+        if (!grafoPlano) return;
+
+        // Si alguien conserva el grafo anterior, se corrige una copia
+        if (grafoPlano.use_count() > 1) grafoPlano = make_shared<GrafoPlano>(*grafoPlano);
+
+        // Un costo que no cabe en el ancho actual pasa los costos al ancho mayor
+        int costoMaximo = 0;
+        for (const auto& [_, costo] : costos) costoMaximo = max(costoMaximo, costo);
+        if (costosParaMaximo(costoMaximo).index() > grafoPlano->costos.index()) {
+            CostosAristas anchos = costosParaMaximo(costoMaximo);
+            visit([&](auto& arreglo) {
+                using Costo = typename decay_t<decltype(arreglo)>::value_type;
+                arreglo.reserve(grafoPlano->vecinos.size());
+                for (size_t e = 0; e < grafoPlano->vecinos.size(); ++e) {
+                    arreglo.push_back(static_cast<Costo>(grafoPlano->costo(static_cast<int>(e))));
+                }
+            }, anchos);
+            grafoPlano->costos = move(anchos);
+        }
+        visit([&](auto& arreglo) {
+            using Costo = typename decay_t<decltype(arreglo)>::value_type;
+            auto corregir = [&](int desde, int hacia, int costo) {
+                for (int e = grafoPlano->inicioAdyacencia[desde]; e < grafoPlano->inicioAdyacencia[desde + 1]; ++e) {
+                    if (grafoPlano->vecinos[e] == hacia) arreglo[e] = static_cast<Costo>(costo);
+                }
+            };
+            for (const auto& [extremos, costo] : costos) {
+                int a = grafoPlano->indices.at(extremos.first);
+                int b = grafoPlano->indices.at(extremos.second);
+                corregir(a, b, costo);
+                corregir(b, a, costo);
+            }
+        }, grafoPlano->costos);
+    }
 
-            if (i != j && enrutadores[origen].obtenerCosto(destino) == numeric_limits<int>::max()) {
-                int costo = rand() % costoMaximo + 1;
-                actualizarEnlace(origen, destino, costo);
-                enlacesActuales++;
+    // Tras agregar o quitar enrutadores y enlaces se conserva la numeración del
+    // grafo plano: los enrutadores eliminados se compactan, los nuevos se agregan
+    // al final y solo se reconstruye la adyacencia a partir de la anterior, sin
+    // volver a recorrer las tablas ni recalcular el orden. Los landmarks, las
+    // estadísticas y la conectividad dependen de la estructura y se recalculan
+    // bajo demanda.
+    void repararEstructuraDerivada(const unordered_set<string>& eliminados, const vector<string>& creados,
+                                   const map<pair<string, string>, int>& cambios) {
+        lock_guard<mutex> bloqueo(mutexDerivado);
+        indiceLandmarks.reset();
+        estadisticas.reset();
+        conectada = -1;
+        if (!grafoPlano) return;
+
+        if (grafoPlano.use_count() > 1) grafoPlano = make_shared<GrafoPlano>(*grafoPlano);
+        GrafoPlano& grafo = *grafoPlano;
+        int n = grafo.numeroNodos();
+
+        // Numeración nueva: se conservan los sobrevivientes en su orden actual
+        vector<int> nuevoIndice(n, -1);
+        vector<string> nombres;
+        nombres.reserve(n + creados.size());
+        for (int v = 0; v < n; ++v) {
+            if (eliminados.count(grafo.nombres[v])) {
+                grafo.indices.erase(grafo.nombres[v]);
+            } else {
+                nuevoIndice[v] = static_cast<int>(nombres.size());
+                nombres.push_back(move(grafo.nombres[v]));
             }
         }
+        for (auto& [_, indice] : grafo.indices) indice = nuevoIndice[indice];
+        for (const auto& nombre : creados) {
+            grafo.indices[nombre] = static_cast<int>(nombres.size());
+            nombres.push_back(nombre);
+        }
+        int total = static_cast<int>(nombres.size());
+
+        // Cambios de enlaces agrupados por extremo (costo negativo = eliminar)
+        unordered_map<int, vector<pair<int, int>>> cambiosPorNodo;
+        int costoMaximo = 0;
+        for (const auto& [extremos, costo] : cambios) {
+            auto a = grafo.indices.find(extremos.first);
+            auto b = grafo.indices.find(extremos.second);
+            if (a == grafo.indices.end() || b == grafo.indices.end()) continue;
+            cambiosPorNodo[a->second].push_back({b->second, costo});
+            if (a->second != b->second) cambiosPorNodo[b->second].push_back({a->second, costo});
+            costoMaximo = max(costoMaximo, costo);
+        }
 
-        registrarCambio("Red aleatoria generada con " + to_string(enlacesActuales) + " enlaces");
+        // Si algún costo nuevo no cabe, los costos pasan al ancho mayor
+        CostosAristas costos = costosMasAnchos(grafo.costos, costosParaMaximo(costoMaximo));
+
+        vector<int> inicio(total + 1, 0);
+        vector<int> vecinos;
+        vecinos.reserve(grafo.vecinos.size());
+        vector<pair<int, int>> fila;
+        visit([&](auto& nuevosCostos) {
+            using Costo = typename decay_t<decltype(nuevosCostos)>::value_type;
+            nuevosCostos.reserve(grafo.vecinos.size());
+            vector<int> original(total, -1);
+            for (int v = 0; v < n; ++v) {
+                if (nuevoIndice[v] != -1) original[nuevoIndice[v]] = v;
+            }
+
+            for (int i = 0; i < total; ++i) {
+                fila.clear();
+                if (int v = original[i]; v != -1) {
+                    for (int e = grafo.inicioAdyacencia[v]; e < grafo.inicioAdyacencia[v + 1]; ++e) {
+                        int vecino = nuevoIndice[grafo.vecinos[e]];
+                        if (vecino != -1) fila.push_back({vecino, grafo.costo(e)});
+                    }
+                }
+                if (auto it = cambiosPorNodo.find(i); it != cambiosPorNodo.end()) {
+                    for (const auto& [vecino, costo] : it->second) {
+                        auto existente = find_if(fila.begin(), fila.end(),
+                                                 [vecino = vecino](const auto& par) { return par.first == vecino; });
+                        if (costo < 0) {
+                            if (existente != fila.end()) fila.erase(existente);
+                        } else if (existente != fila.end()) {
+                            existente->second = costo;
+                        } else {
+                            fila.push_back({vecino, costo});
+                        }
+                    }
+                }
+                for (const auto& [vecino, costo] : fila) {
+                    vecinos.push_back(vecino);
+                    nuevosCostos.push_back(static_cast<Costo>(costo));
+                }
+                inicio[i + 1] = static_cast<int>(vecinos.size());
+            }
+        }, costos);
+
+        grafo.nombres = move(nombres);
+        grafo.inicioAdyacencia = move(inicio);
+        grafo.vecinos = move(vecinos);
+        grafo.costos = move(costos);
     }
 
-    void imprimirRed() const {
-        cout << "\n=== Estado Actual de la Red ===\n";
-        cout << "Número total de enrutadores: " << enrutadores.size() << "\n\n";
+    // Devuelve el índice de landmarks vigente, recalculándolo si la red cambió
+    shared_ptr<const IndiceLandmarks> obtenerIndiceLandmarks() const {
+        lock_guard<mutex> bloqueo(mutexDerivado);
+        if (numLandmarks == 0) {
+            throw logic_error("El modo landmarks no está activado");
+        }
+        if (!indiceLandmarks) {
+            indiceLandmarks = construirIndiceLandmarks(obtenerGrafoPlanoSinBloqueo(),
+                                                       numLandmarks, seleccionLandmarks);
+        }
+        return indiceLandmarks;
+    }
 
-        for (const auto& [nombreEnrutador, enrutador] : enrutadores) {
-            cout << "Enrutador " << nombreEnrutador << ":\n";
-            cout << "  Grado: " << enrutador.obtenerGrado() << " conexiones\n";
-            cout << "  Enlaces:\n";
-            
-            for (const auto& [vecino, costo] : enrutador.obtenerTablaEnrutamiento()) {
-                cout << "    -> " << setw(5) << vecino << " | Costo: " << setw(3) << costo << "\n";
+    static shared_ptr<const IndiceLandmarks> construirIndiceLandmarks(
+            shared_ptr<const GrafoPlano> grafo, int k, SeleccionLandmarks seleccion) {
+        auto indice = make_shared<IndiceLandmarks>();
+        int n = grafo->numeroNodos();
+        indice->grafo = grafo;
+        indice->k = min(k, n);
+        indice->distancias.assign(static_cast<size_t>(n) * indice->k, DISTANCIA_INFINITA);
+        if (indice->k == 0) return indice;
+
+        // Copia la columna del landmark i dentro del arreglo intercalado
+        auto escribirColumna = [&](int i, const vector<uint64_t>& distancias) {
+            for (int v = 0; v < n; ++v) {
+                indice->distancias[static_cast<size_t>(v) * indice->k + i] =
+                    distancias[v] == costoInfinito<uint64_t>()
+                        ? DISTANCIA_INFINITA
+                        : static_cast<int>(min<uint64_t>(distancias[v], IndiceLandmarks::TOPE));
+            }
+        };
+
+        if (seleccion == SeleccionLandmarks::MayorGrado) {
+            vector<int> orden(n);
+            for (int v = 0; v < n; ++v) orden[v] = v;
+            auto grado = [&](int v) { return grafo->inicioAdyacencia[v + 1] - grafo->inicioAdyacencia[v]; };
+            partial_sort(orden.begin(), orden.begin() + indice->k, orden.end(),
+                         [&](int a, int b) { return grado(a) > grado(b); });
+            indice->landmarks.assign(orden.begin(), orden.begin() + indice->k);
+
+            // Los landmarks son independientes: un Dijkstra por landmark repartido entre hilos
+            int numHilos = static_cast<int>(max(1u, thread::hardware_concurrency()));
+            numHilos = min(numHilos, indice->k);
+            vector<thread> hilos;
+            for (int h = 0; h < numHilos; ++h) {
+                hilos.emplace_back([&, h]() {
+                    vector<uint64_t> distancias;
+                    for (int i = h; i < indice->k; i += numHilos) {
+                        calcularDistanciasDesde(*grafo, indice->landmarks[i], distancias);
+                        escribirColumna(i, distancias);
+                    }
+                });
+            }
+            for (auto& hilo : hilos) hilo.join();
+        } else {
+            // Farthest-point: cada selección depende de las distancias anteriores,
+            // así que se calcula en secuencia reutilizando esas mismas distancias
+            vector<uint64_t> distancias;
+            vector<long long> distanciaMinima(n, numeric_limits<long long>::max());
+            calcularDistanciasDesde(*grafo, 0, distancias);
+            auto masLejano = [&](const auto& valores) {
+                int mejor = 0;
+                for (int v = 1; v < n; ++v) {
+                    if (valores[v] > valores[mejor]) mejor = v;
+                }
+                return mejor;
+            };
+            int siguiente = masLejano(distancias);
+
+            for (int i = 0; i < indice->k; ++i) {
+                indice->landmarks.push_back(siguiente);
+                calcularDistanciasDesde(*grafo, siguiente, distancias);
+                escribirColumna(i, distancias);
+                for (int v = 0; v < n; ++v) {
+                    uint64_t d = min<uint64_t>(distancias[v], numeric_limits<long long>::max());
+                    distanciaMinima[v] = min(distanciaMinima[v], static_cast<long long>(d));
+                }
+                for (int landmark : indice->landmarks) distanciaMinima[landmark] = -1;
+                siguiente = masLejano(distanciaMinima);
             }
-            cout << "\n";
         }
+
+        return indice;
     }
 
-    EstadisticasRed obtenerEstadisticas() const {
+    EstadisticasRed calcularEstadisticas() const {
         EstadisticasRed stats{};
         stats.totalEnrutadores = enrutadores.size();
         stats.totalEnlaces = 0;
@@ -315,31 +1771,286 @@ public:
         return stats;
     }
 
-    void imprimirEstadisticas() const {
-        auto stats = obtenerEstadisticas();
-        cout << "\n=== Estadísticas de la Red ===\n";
-        cout << "Total de enrutadores: " << stats.totalEnrutadores << "\n";
-        cout << "Total de enlaces: " << stats.totalEnlaces << "\n";
-        cout << "Costo promedio: " << fixed << setprecision(2) << stats.costoPromedio << "\n";
-        cout << "Costo mínimo: " << stats.costoMinimo << "\n";
-        cout << "Costo máximo: " << stats.costoMaximo << "\n";
-        cout << "Grado máximo: " << stats.gradoMaximo << "\n";
+    void registrarCambio(const string& cambio) {
+        historialCambios.push_back(marcaDeTiempoActual() + ": " + cambio);
     }
+};
 
-    void imprimirHistorial() const {
-        cout << "\n=== Historial de Cambios en la Red ===\n";
-        for (const auto& cambio : historialCambios) {
-            cout << cambio << "\n";
+// Ordenamiento externo de líneas: acumula hasta lineasEnMemoria líneas, las
+// ordena y las escribe como corridas en archivos temporales. Al finalizar, las
+// corridas se mezclan por pasadas de a lo sumo MAX_CORRIDAS_ABIERTAS archivos,
+// de modo que nunca hay más de ese número de corridas abiertas a la vez.
+class OrdenadorExterno {
+private:
+    static constexpr size_t MAX_CORRIDAS_ABIERTAS = 16;
+
+    size_t lineasEnMemoria;
+    vector<string> buffer;
+    deque<string> corridas;
+    vector<unique_ptr<ifstream>> lectores;
+    priority_queue<pair<string, size_t>, vector<pair<string, size_t>>, greater<>> frentes;
+    size_t posicionBuffer = 0;
+    bool mezclando = false;
+
+    string nuevaRutaTemporal() {
+        static int contador = 0;
+        auto ruta = filesystem::temp_directory_path() /
+                    ("corrida_" + to_string(reinterpret_cast<uintptr_t>(this)) + "_" +
+                     to_string(contador++) + ".tmp");
+        return ruta.string();
+    }
+
+    static ofstream crearCorrida(const string& ruta) {
+        ofstream salida(ruta);
+        if (!salida) {
+            throw runtime_error("No se pudo crear el archivo temporal: " + ruta);
         }
+        return salida;
     }
 
-private:
-    void registrarCambio(const string& cambio) {
-        auto tiempo = chrono::system_clock::to_time_t(chrono::system_clock::now());
-        historialCambios.push_back(string(ctime(&tiempo)) + ": " + cambio);
+    static void verificarEscritura(ofstream& salida, const string& ruta) {
+        salida.close();
+        if (!salida) {
+            throw runtime_error("Error al escribir el archivo temporal: " + ruta);
+        }
+    }
+
+    void volcarCorrida() {
+        sort(buffer.begin(), buffer.end());
+        string ruta = nuevaRutaTemporal();
+        ofstream salida = crearCorrida(ruta);
+        for (const auto& linea : buffer) salida << linea << '\n';
+        verificarEscritura(salida, ruta);
+        corridas.push_back(ruta);
+        buffer.clear();
+    }
+
+    // Abre las corridas indicadas como frentes de la mezcla; falla si alguna no se puede abrir
+    void abrirCorridas(size_t cantidad) {
+        lectores.clear();
+        frentes = {};
+        for (size_t i = 0; i < cantidad; ++i) {
+            auto lector = make_unique<ifstream>(corridas[i]);
+            if (!*lector) {
+                throw runtime_error("No se pudo abrir el archivo temporal: " + corridas[i]);
+            }
+            lectores.push_back(move(lector));
+            avanzar(i);
+        }
+    }
+
+    void avanzar(size_t corrida) {
+        string linea;
+        if (getline(*lectores[corrida], linea)) {
+            frentes.push({move(linea), corrida});
+        } else if (lectores[corrida]->bad()) {
+            throw runtime_error("Error al leer un archivo temporal del ordenamiento externo");
+        }
+    }
+
+    // Mezcla las primeras MAX_CORRIDAS_ABIERTAS corridas en una nueva al final de la cola
+    void mezclarPasada() {
+        size_t cantidad = MAX_CORRIDAS_ABIERTAS;
+        abrirCorridas(cantidad);
+        string ruta = nuevaRutaTemporal();
+        ofstream salida = crearCorrida(ruta);
+        while (!frentes.empty()) {
+            auto [menor, corrida] = frentes.top();
+            frentes.pop();
+            salida << menor << '\n';
+            avanzar(corrida);
+        }
+        verificarEscritura(salida, ruta);
+        lectores.clear();
+        for (size_t i = 0; i < cantidad; ++i) {
+            remove(corridas.front().c_str());
+            corridas.pop_front();
+        }
+        corridas.push_back(ruta);
+    }
+
+public:
+    explicit OrdenadorExterno(size_t lineas) : lineasEnMemoria(max<size_t>(lineas, 1)) {}
+
+    OrdenadorExterno(const OrdenadorExterno&) = delete;
+    OrdenadorExterno& operator=(const OrdenadorExterno&) = delete;
+
+    ~OrdenadorExterno() {
+        lectores.clear();
+        for (const auto& ruta : corridas) remove(ruta.c_str());
     }
+
+    void agregar(string linea) {
+        buffer.push_back(move(linea));
+        if (buffer.size() >= lineasEnMemoria) volcarCorrida();
+    }
+
+    // Termina la fase de escritura; lo que queda en memoria se mezcla como una corrida más
+    void finalizar() {
+        sort(buffer.begin(), buffer.end());
+        while (corridas.size() > MAX_CORRIDAS_ABIERTAS) mezclarPasada();
+        abrirCorridas(corridas.size());
+        mezclando = true;
+    }
+
+    bool siguiente(string& linea) {
+        if (!mezclando) finalizar();
+        bool hayBuffer = posicionBuffer < buffer.size();
+        if (!hayBuffer && frentes.empty()) return false;
+        if (hayBuffer && (frentes.empty() || buffer[posicionBuffer] <= frentes.top().first)) {
+            linea = move(buffer[posicionBuffer++]);
+            return true;
+        }
+        auto [menor, corrida] = frentes.top();
+        frentes.pop();
+        linea = move(menor);
+        avanzar(corrida);
+        return true;
+    }
+};
+
+// Enlace normalizado (extremos en orden) leído de un archivo de topología
+struct RegistroEnlace {
+    string origen;
+    string destino;
+    int costo;
+};
+
+// Lee una topología completa hacia dos ordenadores externos: enlaces y nombres.
+// Los enlaces se guardan como "A B secuencia costo" con la secuencia rellenada
+// a ancho fijo, de modo que entre duplicados la última aparición queda al final.
+void ordenarTopologia(const string& nombreArchivo, OrdenadorExterno& enlaces, OrdenadorExterno& nombres) {
+    ifstream archivo(nombreArchivo);
+    if (!archivo) {
+        throw runtime_error("No se pudo abrir el archivo: " + nombreArchivo);
+    }
+
+    string linea;
+    int numLinea = 0;
+    char secuencia[24];
+    while (getline(archivo, linea)) {
+        numLinea++;
+        if (linea.empty() || linea[0] == '#') continue;
+
+        stringstream ss(linea);
+        string origen, destino;
+        int costo;
+        if (!(ss >> origen >> destino >> costo)) {
+            throw runtime_error("Error en formato de línea " + to_string(numLinea) + " de " + nombreArchivo);
+        }
+        if (destino < origen) swap(origen, destino);
+        snprintf(secuencia, sizeof(secuencia), "%012d", numLinea);
+        enlaces.agregar(origen + ' ' + destino + ' ' + secuencia + ' ' + to_string(costo));
+        nombres.agregar(origen);
+        nombres.agregar(destino);
+    }
+    enlaces.finalizar();
+    nombres.finalizar();
+}
+
+// Siguiente enlace distinto en orden; si un enlace se repite, gana su última aparición
+bool siguienteEnlace(OrdenadorExterno& enlaces, string& pendiente, RegistroEnlace& registro) {
+    if (pendiente.empty() && !enlaces.siguiente(pendiente)) return false;
+
+    string secuencia;
+    stringstream(pendiente) >> registro.origen >> registro.destino >> secuencia >> registro.costo;
+    string linea, origen, destino;
+    pendiente.clear();
+    while (enlaces.siguiente(linea)) {
+        stringstream ss(linea);
+        ss >> origen >> destino;
+        if (origen != registro.origen || destino != registro.destino) {
+            pendiente = move(linea);
+            break;
+        }
+        ss >> secuencia >> registro.costo;
+    }
+    return true;
+}
+
+bool siguienteNombre(OrdenadorExterno& nombres, string& nombre) {
+    string anterior = nombre;
+    while (nombres.siguiente(nombre)) {
+        if (nombre != anterior) return true;
+    }
+    return false;
+}
+
+// Resumen del delta generado por calcularDeltaTopologias
+struct ResumenDelta {
+    int enrutadoresEliminados = 0;
+    int enlacesAgregados = 0;
+    int enlacesEliminados = 0;
+    int costosCambiados = 0;
 };
 
+// Escribe en archivoDelta los cambios mínimos que convierten la topología
+// anterior en la nueva, en el formato de Red::aplicarDeltaDesdeArchivo. Ambos
+// archivos se ordenan externamente, así que pueden ser más grandes que la RAM;
+// solo los nombres de los enrutadores eliminados se mantienen en memoria. Los
+// cuatro ordenadores tienen a lo sumo 4 * 16 corridas abiertas durante la mezcla.
+ResumenDelta calcularDeltaTopologias(const string& archivoAnterior, const string& archivoNuevo,
+                                     const string& archivoDelta, size_t lineasEnMemoria = 1 << 20) {
+    OrdenadorExterno enlacesAnteriores(lineasEnMemoria), nombresAnteriores(lineasEnMemoria);
+    OrdenadorExterno enlacesNuevos(lineasEnMemoria), nombresNuevos(lineasEnMemoria);
+    ordenarTopologia(archivoAnterior, enlacesAnteriores, nombresAnteriores);
+    ordenarTopologia(archivoNuevo, enlacesNuevos, nombresNuevos);
+
+    ofstream salida(archivoDelta);
+    if (!salida) {
+        throw runtime_error("No se pudo crear el archivo: " + archivoDelta);
+    }
+    ResumenDelta resumen;
+
+    // Enrutadores que desaparecen: un "- A" quita también todos sus enlaces
+    unordered_set<string> eliminados;
+    string anterior, nuevo;
+    bool hayAnterior = siguienteNombre(nombresAnteriores, anterior);
+    bool hayNuevo = siguienteNombre(nombresNuevos, nuevo);
+    while (hayAnterior) {
+        if (!hayNuevo || anterior < nuevo) {
+            salida << "- " << anterior << '\n';
+            eliminados.insert(anterior);
+            resumen.enrutadoresEliminados++;
+            hayAnterior = siguienteNombre(nombresAnteriores, anterior);
+        } else {
+            if (anterior == nuevo) hayAnterior = siguienteNombre(nombresAnteriores, anterior);
+            hayNuevo = siguienteNombre(nombresNuevos, nuevo);
+        }
+    }
+
+    // Mezcla de los enlaces ordenados de ambos archivos
+    RegistroEnlace a, b;
+    string pendienteA, pendienteB;
+    bool hayA = siguienteEnlace(enlacesAnteriores, pendienteA, a);
+    bool hayB = siguienteEnlace(enlacesNuevos, pendienteB, b);
+    while (hayA || hayB) {
+        int comparacion = !hayA ? 1 : !hayB ? -1
+                        : a.origen != b.origen ? (a.origen < b.origen ? -1 : 1)
+                        : a.destino != b.destino ? (a.destino < b.destino ? -1 : 1) : 0;
+        if (comparacion < 0) {
+            if (!eliminados.count(a.origen) && !eliminados.count(a.destino)) {
+                salida << "- " << a.origen << ' ' << a.destino << '\n';
+                resumen.enlacesEliminados++;
+            }
+            hayA = siguienteEnlace(enlacesAnteriores, pendienteA, a);
+        } else if (comparacion > 0) {
+            salida << "+ " << b.origen << ' ' << b.destino << ' ' << b.costo << '\n';
+            resumen.enlacesAgregados++;
+            hayB = siguienteEnlace(enlacesNuevos, pendienteB, b);
+        } else {
+            if (a.costo != b.costo) {
+                salida << "~ " << b.origen << ' ' << b.destino << ' ' << b.costo << '\n';
+                resumen.costosCambiados++;
+            }
+            hayA = siguienteEnlace(enlacesAnteriores, pendienteA, a);
+            hayB = siguienteEnlace(enlacesNuevos, pendienteB, b);
+        }
+    }
+
+    return resumen;
+}
+
 // ... [código anterior se mantiene igual hasta ejecutarPruebas] ...
 
 void ejecutarPruebas(Red& red) {
@@ -409,6 +2120,484 @@ void ejecutarPruebas(Red& red) {
     } catch (const exception& e) {
         cout << "Error en Prueba 5: " << e.what() << "\n";
     }
+
+    // Prueba 6: Oráculo de distancias con landmarks
+    try {
+        cout << "\nPrueba 6: Comparando cotas ALT con Dijkstra...\n";
+        red.activarLandmarks(2);
+        for (const auto& [origen, destino] : vector<pair<string, string>>{{"E0", "E4"}, {"E1", "E3"}}) {
+            auto cotas = red.estimarCosto(origen, destino);
+            auto exacta = red.encontrarRutaMasCorta(origen, destino).first;
+            auto alt = red.encontrarRutaMasCortaALT(origen, destino).first;
+            cout << origen << " -> " << destino << ": cotas [" << cotas.inferior << ", "
+                 << cotas.superior << "], Dijkstra " << exacta << ", A* " << alt
+                 << ((cotas.inferior <= exacta && exacta <= cotas.superior && alt == exacta) ? " (OK)" : " (ERROR)")
+                 << "\n";
+        }
+        red.desactivarLandmarks();
+    } catch (const exception& e) {
+        cout << "Error en Prueba 6: " << e.what() << "\n";
+    }
+
+    // Prueba 7: Transacciones de enlaces
+    try {
+        cout << "\nPrueba 7: Aplicando cambios en una transacción...\n";
+        TransaccionRed transaccion;
+        transaccion.agregarEnlace("E0", "E5", 4)
+                   .cambiarCosto("E0", "E1", 2)
+                   .eliminarEnlace("E1", "E2");
+        red.confirmarTransaccion(transaccion);
+        cout << "Transacción confirmada. Costo E0 -> E5: "
+             << red.encontrarRutaMasCorta("E0", "E5").first << "\n";
+
+        TransaccionRed invalida;
+        invalida.agregarEnlace("E0", "E6", 1).eliminarEnrutador("E99");
+        try {
+            red.confirmarTransaccion(invalida);
+            cout << "ERROR: se aceptó una transacción inválida\n";
+        } catch (const invalid_argument& e) {
+            cout << "Transacción rechazada (" << e.what() << "); E6 "
+                 << (red.existeEnrutador("E6") ? "existe (ERROR)" : "no se creó (OK)") << "\n";
+        }
+    } catch (const exception& e) {
+        cout << "Error en Prueba 7: " << e.what() << "\n";
+    }
+
+    // Prueba 8: Archivo de cambios aplicado sobre la red actual
+    try {
+        cout << "\nPrueba 8: Aplicando un archivo de cambios...\n";
+        string archivoCambios = (filesystem::temp_directory_path() / "cambios_prueba.txt").string();
+        {
+            ofstream cambios(archivoCambios);
+            cambios << "+ E3 E6 2\n~ E0 E1 3\n- E6\n";
+        }
+        red.aplicarDeltaDesdeArchivo(archivoCambios);
+        remove(archivoCambios.c_str());
+        cout << "Costo E0 -> E1: " << red.encontrarRutaMasCorta("E0", "E1").first
+             << ", E6 " << (red.existeEnrutador("E6") ? "existe (ERROR)" : "eliminado (OK)") << "\n";
+    } catch (const exception& e) {
+        cout << "Error en Prueba 8: " << e.what() << "\n";
+    }
+
+    // Prueba 9: Rutas sin copias de nombres
+    try {
+        cout << "\nPrueba 9: Consultando rutas como vistas de índices...\n";
+        // La vista es válida hasta la siguiente consulta del hilo: el envoltorio va primero
+        auto [costo, nombres] = red.encontrarRutaMasCorta("E0", "E4");
+        auto ruta = red.consultarRuta("E0", "E4");
+        bool coincide = ruta.existe() && static_cast<int>(ruta.costo()) == costo && ruta.size() == nombres.size();
+        for (size_t i = 0; coincide && i < ruta.size(); ++i) coincide = ruta.nombre(i) == nombres[i];
+        cout << "E0 -> E4: " << ruta.saltos() << " saltos, siguiente salto "
+             << (ruta.siguienteSalto() != -1 ? ruta.nombre(1) : string_view("ninguno"))
+             << (coincide ? " (OK)" : " (ERROR)") << "\n";
+
+        red.agregarEnrutador("Aislado");
+        auto inalcanzable = red.consultarRuta("E0", "Aislado");
+        bool sinRuta = !inalcanzable.existe() && inalcanzable.saltos() == 0 && inalcanzable.siguienteSalto() == -1;
+        cout << "E0 -> Aislado: " << (inalcanzable.existe() ? "con ruta" : "sin ruta")
+             << (sinRuta && red.encontrarRutaMasCorta("E0", "Aislado").first == -1 ? " (OK)" : " (ERROR)") << "\n";
+
+        auto trivial = red.consultarRuta("E0", "E0");
+        bool mismo = trivial.existe() && trivial.saltos() == 0 && trivial.siguienteSalto() == -1 &&
+                     trivial.costo() == 0 && trivial.size() == 1 && trivial.nombre(0) == "E0";
+        cout << "E0 -> E0: " << trivial.saltos() << " saltos, costo " << trivial.costo()
+             << (mismo ? " (OK)" : " (ERROR)") << "\n";
+    } catch (const exception& e) {
+        cout << "Error en Prueba 9: " << e.what() << "\n";
+    }
+
+    // Prueba 10: Tablas grandes y pequeñas compartiendo la arena
+    try {
+        cout << "\nPrueba 10: Construyendo un concentrador con más de 2048 enlaces...\n";
+        AlmacenEnlaces almacen;
+        TablaPlana concentrador(almacen);
+        for (int i = 0; i < 3000; ++i) concentrador.actualizar("H" + to_string(i), i % 50 + 1);
+        vector<TablaPlana> pequenas(50, TablaPlana(almacen));
+        for (size_t t = 0; t < pequenas.size(); ++t) {
+            for (int i = 0; i < 5; ++i) pequenas[t].actualizar("P" + to_string(t * 5 + i), i + 1);
+        }
+        bool correcto = concentrador.size() == 3000;
+        for (int i = 0; i < 3000 && correcto; ++i) {
+            correcto = concentrador.costo("H" + to_string(i)) == i % 50 + 1;
+        }
+        for (size_t t = 0; t < pequenas.size() && correcto; ++t) {
+            for (int i = 0; i < 5 && correcto; ++i) {
+                correcto = pequenas[t].costo("P" + to_string(t * 5 + i)) == i + 1;
+            }
+        }
+        cout << "Concentrador de " << concentrador.size() << " enlaces y " << pequenas.size()
+             << " tablas pequeñas" << (correcto ? " (OK)" : " (ERROR)") << "\n";
+    } catch (const exception& e) {
+        cout << "Error en Prueba 10: " << e.what() << "\n";
+    }
+
+    // Prueba 11: Rutas más largas que INT_MAX frente a destinos inalcanzables
+    try {
+        cout << "\nPrueba 11: Distinguiendo rutas muy largas de rutas inexistentes...\n";
+        Red larga;
+        for (const string nombre : {"A", "B", "C", "D", "E"}) larga.agregarEnrutador(nombre);
+        larga.actualizarEnlace("A", "B", 2000000000);
+        larga.actualizarEnlace("B", "C", 2000000000);
+        larga.actualizarEnlace("C", "D", 5);
+        larga.actualizarEnlace("D", "E", 2000000000);
+        uint64_t costo = larga.calcularCostoAcumulado("A", "E");
+        bool correcto = costo == 6000000005ULL && larga.encontrarRutaMasCorta("A", "E").first == -1 &&
+                        larga.esRedConectada();
+        cout << "A -> E: costo " << costo << ", red " << (larga.esRedConectada() ? "conectada" : "no conectada")
+             << (correcto ? " (OK)" : " (ERROR)") << "\n";
+
+        // El concentrador A es el landmark de mayor grado; D queda a más de INT_MAX de él
+        for (const string nombre : {"X1", "X2", "X3"}) {
+            larga.agregarEnrutador(nombre);
+            larga.actualizarEnlace("A", nombre, 1);
+        }
+        larga.actualizarEnlace("A", "C", numeric_limits<int>::max() - 1);
+        larga.activarLandmarks(1, SeleccionLandmarks::MayorGrado);
+        auto cotas = larga.estimarCosto("C", "D");
+        bool cotasValidas = cotas.alcanzable && cotas.inferior <= 5 && cotas.superior >= 5;
+        cout << "C -> D: cota inferior " << cotas.inferior
+             << (cotasValidas ? ", alcanzable (OK)" : " (ERROR)") << "\n";
+    } catch (const exception& e) {
+        cout << "Error en Prueba 11: " << e.what() << "\n";
+    }
+
+    // Prueba 12: Delta entre dos topologías con mezcla externa en varias pasadas
+    try {
+        cout << "\nPrueba 12: Calculando y aplicando el delta entre dos topologías...\n";
+        auto temporal = [](const string& nombre) { return (filesystem::temp_directory_path() / nombre).string(); };
+        string anterior = temporal("delta_anterior.txt");
+        string nueva = temporal("delta_nueva.txt");
+        string delta = temporal("delta_prueba.txt");
+
+        map<pair<string, string>, int> enlacesAnteriores, enlacesNuevos;
+        auto nombre = [](int i) { return "N" + to_string(i); };
+        for (int i = 0; i < 40; ++i) {
+            enlacesAnteriores[minmax(nombre(i), nombre((i + 1) % 40))] = i % 7 + 1;
+            if ((i * 7 + 3) % 40 != i) enlacesAnteriores[minmax(nombre(i), nombre((i * 7 + 3) % 40))] = 2;
+        }
+        // Se eliminan enlaces, se cambian costos, desaparece N7 y aparecen M0..M2
+        int indice = 0;
+        for (const auto& [enlace, costo] : enlacesAnteriores) {
+            ++indice;
+            if (indice % 5 == 0 || enlace.first == "N7" || enlace.second == "N7") continue;
+            enlacesNuevos[enlace] = indice % 3 == 0 ? costo + 10 : costo;
+        }
+        for (int i = 0; i < 3; ++i) enlacesNuevos[minmax("M" + to_string(i), nombre(i * 9))] = i + 1;
+
+        auto escribir = [](const string& archivo, const map<pair<string, string>, int>& enlaces) {
+            ofstream salida(archivo);
+            for (const auto& [enlace, costo] : enlaces) {
+                salida << enlace.first << " " << enlace.second << " " << costo << "\n";
+            }
+        };
+        escribir(anterior, enlacesAnteriores);
+        escribir(nueva, enlacesNuevos);
+
+        // Con 2 líneas por corrida hay bastante más de MAX_CORRIDAS_ABIERTAS corridas
+        auto resumen = calcularDeltaTopologias(anterior, nueva, delta, 2);
+        Red actualizada, esperada;
+        actualizada.cargarTopologiaDesdeArchivo(anterior);
+        actualizada.aplicarDeltaDesdeArchivo(delta);
+        esperada.cargarTopologiaDesdeArchivo(nueva);
+        for (const auto& archivo : {anterior, nueva, delta}) remove(archivo.c_str());
+
+        auto aristas = [](const Red& red) {
+            auto grafo = red.obtenerGrafoPlano();
+            set<tuple<string, string, int>> resultado;
+            for (int v = 0; v < grafo->numeroNodos(); ++v) {
+                for (int e = grafo->inicioAdyacencia[v]; e < grafo->inicioAdyacencia[v + 1]; ++e) {
+                    resultado.insert({grafo->nombres[v], grafo->nombres[grafo->vecinos[e]], grafo->costo(e)});
+                }
+            }
+            return make_pair(set<string>(grafo->nombres.begin(), grafo->nombres.end()), resultado);
+        };
+        bool iguales = aristas(actualizada) == aristas(esperada);
+        cout << "Eliminados " << resumen.enrutadoresEliminados << ", agregados " << resumen.enlacesAgregados
+             << ", quitados " << resumen.enlacesEliminados << ", cambiados " << resumen.costosCambiados
+             << (iguales && resumen.enrutadoresEliminados == 1 ? " (OK)" : " (ERROR)") << "\n";
+    } catch (const exception& e) {
+        cout << "Error en Prueba 12: " << e.what() << "\n";
+    }
+
+    // Prueba 13: Cada numeración es una permutación y no cambia los costos
+    try {
+        cout << "\nPrueba 13: Comparando rutas con cada numeración de enrutadores...\n";
+        Red numerada;
+        numerada.generarRedAleatoria(40, 20, 0.08);
+        auto base = numerada.obtenerGrafoPlano();
+        int n = base->numeroNodos();
+        vector<int> costosBase;
+        for (int a = 0; a < n; ++a) {
+            for (int b = 0; b < n; ++b) {
+                costosBase.push_back(numerada.encontrarRutaMasCorta(base->nombres[a], base->nombres[b]).first);
+            }
+        }
+
+        const vector<pair<OrdenEnrutadores, string>> criterios = {
+            {OrdenEnrutadores::BFS, "BFS"},
+            {OrdenEnrutadores::CuthillMcKeeInverso, "RCM"},
+            {OrdenEnrutadores::Gorder, "Gorder"}
+        };
+        for (const auto& [criterio, nombre] : criterios) {
+            auto orden = calcularOrden(*base, criterio);
+            vector<int> ordenado(orden);
+            sort(ordenado.begin(), ordenado.end());
+            bool permutacion = static_cast<int>(orden.size()) == n;
+            for (int i = 0; permutacion && i < n; ++i) permutacion = ordenado[i] == i;
+
+            numerada.establecerOrdenEnrutadores(criterio);
+            bool mismosCostos = true;
+            for (int a = 0; a < n && mismosCostos; ++a) {
+                for (int b = 0; b < n && mismosCostos; ++b) {
+                    mismosCostos = numerada.encontrarRutaMasCorta(base->nombres[a], base->nombres[b]).first ==
+                                   costosBase[static_cast<size_t>(a) * n + b];
+                }
+            }
+            cout << setw(8) << nombre << ": " << (permutacion ? "permutación" : "no es permutación")
+                 << ", costos " << (mismosCostos ? "iguales" : "distintos")
+                 << (permutacion && mismosCostos ? " (OK)" : " (ERROR)") << "\n";
+        }
+    } catch (const exception& e) {
+        cout << "Error en Prueba 13: " << e.what() << "\n";
+    }
+}
+
+// Cuenta fallos de caché del hilo actual con perf_event_open cuando el sistema lo permite
+class ContadorFallosCache {
+private:
+    int descriptor = -1;
+
+public:
+    ContadorFallosCache() {
+#ifdef __linux__
+        perf_event_attr atributos{};
+        atributos.type = PERF_TYPE_HARDWARE;
+        atributos.size = sizeof(atributos);
+        atributos.config = PERF_COUNT_HW_CACHE_MISSES;
+        atributos.disabled = 1;
+        atributos.exclude_kernel = 1;
+        atributos.exclude_hv = 1;
+        descriptor = static_cast<int>(syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0));
+#endif
+    }
+
+    ~ContadorFallosCache() {
+#ifdef __linux__
+        if (descriptor != -1) close(descriptor);
+#endif
+    }
+
+    ContadorFallosCache(const ContadorFallosCache&) = delete;
+    ContadorFallosCache& operator=(const ContadorFallosCache&) = delete;
+
+    bool disponible() const { return descriptor != -1; }
+
+    void iniciar() {
+#ifdef __linux__
+        if (!disponible()) return;
+        ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+        ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    // Devuelve los fallos contados desde iniciar(), o -1 si no hay contador
+    long long detener() {
+        long long fallos = -1;
+#ifdef __linux__
+        if (!disponible()) return -1;
+        ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(descriptor, &fallos, sizeof(fallos)) != sizeof(fallos)) fallos = -1;
+#endif
+        return fallos;
+    }
+};
+
+// Compara los criterios de numeración sobre la red actual (cargada o generada)
+void ejecutarBenchmarkOrden(Red& red, int numConsultas = 20) {
+    const vector<pair<OrdenEnrutadores, string>> criterios = {
+        {OrdenEnrutadores::Ninguno, "Ninguno"},
+        {OrdenEnrutadores::BFS, "BFS"},
+        {OrdenEnrutadores::CuthillMcKeeInverso, "RCM"},
+        {OrdenEnrutadores::Gorder, "Gorder"}
+    };
+
+    // Todos los criterios parten del grafo plano sin renumerar, como hace la Red;
+    // al terminar se vuelve al criterio que eligió el usuario
+    OrdenEnrutadores ordenPrevio = red.obtenerOrdenEnrutadores();
+    red.establecerOrdenEnrutadores(OrdenEnrutadores::Ninguno);
+    auto inicio = chrono::steady_clock::now();
+    auto base = red.obtenerGrafoPlano();
+    double msConstruccion = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+    red.establecerOrdenEnrutadores(ordenPrevio);
+    if (base->numeroNodos() == 0) {
+        cout << "La red está vacía\n";
+        return;
+    }
+
+    // Los mismos orígenes para todos los criterios, elegidos por nombre
+    vector<string> origenes;
+    for (int i = 0; i < numConsultas; ++i) {
+        origenes.push_back(base->nombres[rand() % base->numeroNodos()]);
+    }
+
+    ContadorFallosCache contador;
+    cout << "\n=== Benchmark de numeración de enrutadores ===\n";
+    cout << "Enrutadores: " << base->numeroNodos() << ", enlaces: " << base->vecinos.size() / 2
+         << ", consultas: " << numConsultas << ", bytes por costo: " << base->bytesPorCosto() << "\n";
+    cout << "Construcción del grafo plano desde las tablas: " << fixed << setprecision(2)
+         << msConstruccion << " ms\n";
+    cout << setw(10) << "Orden" << setw(16) << "Reordenar (ms)" << setw(14) << "Salto medio"
+         << setw(16) << "Dijkstra (ms)" << setw(18) << "Fallos de caché" << "\n";
+
+    // Solo se mide calcularOrden + renumerarGrafo, sin la construcción desde las tablas
+    vector<int> distancias;
+    for (const auto& [criterio, nombre] : criterios) {
+        auto grafo = base;
+        double msReordenar = 0;
+        if (criterio != OrdenEnrutadores::Ninguno) {
+            inicio = chrono::steady_clock::now();
+            grafo = make_shared<const GrafoPlano>(renumerarGrafo(*base, calcularOrden(*base, criterio)));
+            msReordenar = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+        }
+
+        // Distancia media entre los índices de los extremos de cada enlace
+        double saltoMedio = 0;
+        for (int v = 0; v < grafo->numeroNodos(); ++v) {
+            for (int e = grafo->inicioAdyacencia[v]; e < grafo->inicioAdyacencia[v + 1]; ++e) {
+                saltoMedio += abs(grafo->vecinos[e] - v);
+            }
+        }
+        if (!grafo->vecinos.empty()) saltoMedio /= grafo->vecinos.size();
+
+        contador.iniciar();
+        inicio = chrono::steady_clock::now();
+        for (const auto& origen : origenes) {
+            calcularDistanciasDesde(*grafo, grafo->indices.at(origen), distancias);
+        }
+        double msDijkstra = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+        long long fallos = contador.detener();
+
+        cout << setw(10) << nombre << setw(16) << fixed << setprecision(2) << msReordenar
+             << setw(14) << setprecision(1) << saltoMedio << setw(16) << setprecision(2) << msDijkstra
+             << setw(18) << (fallos >= 0 ? to_string(fallos) : string("no disponible")) << "\n";
+    }
+}
+
+// Bytes reservados con malloc, o -1 si la biblioteca de C no lo informa. Se
+// suman los bloques servidos con mmap: glibc sube el umbral de mmap tras liberar
+// bloques grandes, y sin ellos la medida dependería de lo que se midió antes.
+long long memoriaEnUso() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    auto info = mallinfo2();
+    return static_cast<long long>(info.uordblks + info.hblkhd);
+#else
+    return -1;
+#endif
+}
+
+template <typename Tabla>
+void medirTabla(const string& nombre, const vector<string>& nombres,
+                const vector<pair<int, int>>& enlaces, const vector<pair<int, int>>& consultas) {
+    // El almacén entra en la medición: incluye la tabla de nombres de la tabla plana
+    long long memoriaInicial = memoriaEnUso();
+    auto inicio = chrono::steady_clock::now();
+    AlmacenEnlaces almacen;
+    vector<Tabla> tablas(nombres.size(), Tabla(almacen));
+    for (const auto& [a, b] : enlaces) {
+        tablas[a].actualizar(nombres[b], 1 + (a + b) % 100);
+        tablas[b].actualizar(nombres[a], 1 + (a + b) % 100);
+    }
+    double msConstruccion = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+    long long memoria = memoriaEnUso() - memoriaInicial;
+
+    inicio = chrono::steady_clock::now();
+    long long suma = 0;
+    for (const auto& [a, b] : consultas) {
+        int costo = tablas[a].costo(nombres[b]);
+        if (costo != DISTANCIA_INFINITA) suma += costo;
+    }
+    double nsConsulta = chrono::duration<double, nano>(chrono::steady_clock::now() - inicio).count() / consultas.size();
+
+    cout << setw(12) << nombre << setw(16) << fixed << setprecision(2) << msConstruccion
+         << setw(16) << (memoria >= 0 ? to_string(memoria / 1024) + " KiB" : string("no disponible"))
+         << setw(16) << setprecision(1) << nsConsulta << "  (suma " << suma << ")\n";
+
+    if constexpr (is_same_v<Tabla, TablaPlana>) {
+        vector<uint32_t> ids;
+        for (const auto& destino : nombres) ids.push_back(almacen.nombres.internar(destino));
+        inicio = chrono::steady_clock::now();
+        suma = 0;
+        for (const auto& [a, b] : consultas) {
+            int costo = tablas[a].costoPorId(ids[b]);
+            if (costo != DISTANCIA_INFINITA) suma += costo;
+        }
+        nsConsulta = chrono::duration<double, nano>(chrono::steady_clock::now() - inicio).count() / consultas.size();
+        cout << setw(12) << nombre + " (id)" << setw(32) << "" << setw(16) << setprecision(1) << nsConsulta
+             << "  (suma " << suma << ")\n";
+    }
+}
+
+// Memoria de una Red completa cargada enlace a enlace con el backend compilado:
+// incluye el mapa de enrutadores por nombre, los objetos Enrutador, su almacén
+// y los historiales, y aparte el grafo plano que se construye en la primera consulta
+void medirRed(bool historial, const vector<string>& nombres, const vector<pair<int, int>>& enlaces) {
+    bool historialPrevio = Enrutador::obtenerHistorialDetallado();
+    Enrutador::establecerHistorialDetallado(historial);
+    long long memoriaInicial = memoriaEnUso();
+    {
+        auto inicio = chrono::steady_clock::now();
+        Red red;
+        for (const auto& nombre : nombres) red.agregarEnrutador(nombre);
+        for (const auto& [a, b] : enlaces) red.actualizarEnlace(nombres[a], nombres[b], 1 + (a + b) % 100);
+        double msConstruccion = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+        long long memoria = memoriaEnUso() - memoriaInicial;
+        red.obtenerGrafoPlano();
+        long long memoriaGrafo = memoriaEnUso() - memoriaInicial - memoria;
+
+        auto enKiB = [memoriaInicial](long long bytes) {
+            return memoriaInicial >= 0 ? to_string(bytes / 1024) + " KiB" : string("no disponible");
+        };
+        cout << setw(12) << (historial ? "Red (hist.)" : "Red") << setw(16) << fixed << setprecision(2)
+             << msConstruccion << setw(16) << enKiB(memoria) << "  (+ " << enKiB(memoriaGrafo)
+             << " de grafo plano)\n";
+    }
+    Enrutador::establecerHistorialDetallado(historialPrevio);
+}
+
+// Compara la tabla plana con la tabla basada en unordered_map
+void ejecutarBenchmarkTablas(int numEnrutadores = 200000, int gradoMedio = 4) {
+    vector<string> nombres;
+    nombres.reserve(numEnrutadores);
+    for (int i = 0; i < numEnrutadores; ++i) nombres.push_back("B" + to_string(i));
+
+    vector<pair<int, int>> enlaces;
+    for (long long i = 0; i < static_cast<long long>(numEnrutadores) * gradoMedio / 2; ++i) {
+        int a = rand() % numEnrutadores;
+        int b = rand() % numEnrutadores;
+        if (a != b) enlaces.push_back({a, b});
+    }
+    // La mitad de las consultas acierta un enlace existente
+    vector<pair<int, int>> consultas;
+    for (size_t i = 0; i < enlaces.size(); ++i) {
+        consultas.push_back(i % 2 ? enlaces[i] : make_pair(rand() % numEnrutadores, rand() % numEnrutadores));
+    }
+
+    cout << "\n=== Benchmark de tablas de enrutamiento ===\n";
+    cout << "Enrutadores: " << numEnrutadores << ", enlaces: " << enlaces.size()
+         << ", consultas: " << consultas.size() << "\n";
+    cout << setw(12) << "Tabla" << setw(16) << "Construir (ms)" << setw(16) << "Memoria"
+         << setw(16) << "Consulta (ns)" << "\n";
+    medirTabla<TablaHash>("Hash", nombres, enlaces, consultas);
+    medirTabla<TablaPlana>("Plana", nombres, enlaces, consultas);
+
+    // Las tablas solas no cuentan lo que una Red real añade por enrutador
+#ifdef ENRUTADOR_TABLA_HASH
+    cout << "\nRed completa con tabla Hash, con y sin historial por enrutador:\n";
+#else
+    cout << "\nRed completa con tabla Plana, con y sin historial por enrutador:\n";
+#endif
+    medirRed(true, nombres, enlaces);
+    medirRed(false, nombres, enlaces);
 }
 
 int main() {
@@ -429,6 +2618,13 @@ int main() {
             cout << "8. Mostrar estadísticas\n";
             cout << "9. Mostrar historial\n";
             cout << "10. Ejecutar pruebas\n";
+            cout << "11. Activar landmarks (ALT)\n";
+            cout << "12. Estimar costo con landmarks\n";
+            cout << "13. Benchmark de numeración de enrutadores\n";
+            cout << "14. Benchmark de tablas de enrutamiento\n";
+            cout << "15. Aplicar cambios desde archivo\n";
+            cout << "16. Calcular cambios entre dos topologías\n";
+            cout << "17. Elegir numeración de enrutadores\n";
             cout << "0. Salir\n";
             cout << "Seleccione una opción: ";
 
@@ -516,6 +2712,77 @@ int main() {
                 case 10:
                     ejecutarPruebas(red);
                     break;
+                case 11: {
+                    cout << "Ingrese número de landmarks: ";
+                    int k;
+                    cin >> k;
+                    cout << "Selección (0 = más lejano, 1 = mayor grado): ";
+                    int seleccion;
+                    cin >> seleccion;
+                    red.activarLandmarks(k, seleccion == 1 ? SeleccionLandmarks::MayorGrado
+                                                           : SeleccionLandmarks::MasLejano);
+                    break;
+                }
+                case 12: {
+                    cout << "Ingrese enrutador origen: ";
+                    string origen;
+                    getline(cin, origen);
+                    cout << "Ingrese enrutador destino: ";
+                    string destino;
+                    getline(cin, destino);
+                    auto cotas = red.estimarCosto(origen, destino);
+                    if (cotas.alcanzable) {
+                        cout << "Costo entre " << cotas.inferior << " y ";
+                        if (cotas.superior == DISTANCIA_INFINITA) cout << "desconocido";
+                        else cout << cotas.superior;
+                        cout << "\n";
+                    } else {
+                        cout << "No existe ruta entre los enrutadores especificados\n";
+                    }
+                    break;
+                }
+                case 13:
+                    ejecutarBenchmarkOrden(red);
+                    break;
+                case 14:
+                    ejecutarBenchmarkTablas();
+                    break;
+                case 15: {
+                    cout << "Ingrese nombre del archivo de cambios: ";
+                    string nombreArchivo;
+                    getline(cin, nombreArchivo);
+                    red.aplicarDeltaDesdeArchivo(nombreArchivo);
+                    break;
+                }
+                case 16: {
+                    cout << "Ingrese topología anterior: ";
+                    string anterior;
+                    getline(cin, anterior);
+                    cout << "Ingrese topología nueva: ";
+                    string nueva;
+                    getline(cin, nueva);
+                    cout << "Ingrese archivo de salida: ";
+                    string salida;
+                    getline(cin, salida);
+                    auto resumen = calcularDeltaTopologias(anterior, nueva, salida);
+                    cout << "Enrutadores eliminados: " << resumen.enrutadoresEliminados
+                         << ", enlaces agregados: " << resumen.enlacesAgregados
+                         << ", enlaces eliminados: " << resumen.enlacesEliminados
+                         << ", costos cambiados: " << resumen.costosCambiados << "\n";
+                    break;
+                }
+                case 17: {
+                    cout << "Numeración (0 = ninguna, 1 = BFS, 2 = Cuthill-McKee inverso, 3 = Gorder): ";
+                    int orden;
+                    cin >> orden;
+                    if (orden < 0 || orden > 3) {
+                        cout << "Opción inválida\n";
+                        break;
+                    }
+                    red.establecerOrdenEnrutadores(static_cast<OrdenEnrutadores>(orden));
+                    cout << "Las consultas usarán la nueva numeración\n";
+                    break;
+                }
                 case 0:
                     cout << "Saliendo del programa...\n";
                     return 0;